@@ -24,6 +24,7 @@
 
 #include <inttypes.h>
 #include "Print.h"
+#include "StreamMatcher.h"
 
 // compatability macros for testing
 /*
@@ -42,11 +43,15 @@ class Stream : public Print
     unsigned long _startMillis;  // used for timeout measurement
     int timedRead();    // private method to read stream with timeout
     int timedPeek();    // private method to peek stream with timeout
+    int timedRead(uint8_t *buffer, size_t size); // reads what is there, waiting up to the timeout for the first byte
     int peekNextDigit(); // returns the next numeric digit in the stream or -1 if timeout
 
   public:
     virtual int available() = 0;
     virtual int read() = 0;
+    virtual int read(uint8_t *buffer, size_t size); // reads up to size bytes without waiting
+    // returns the number read. Transports that can copy in bulk override this,
+    // readBytes() and readString() go through it
     virtual int peek() = 0;
     virtual void flush() = 0;
 
@@ -66,6 +71,9 @@ class Stream : public Print
 
   bool findUntil(char *target, size_t targetLen, char *terminate, size_t termLen);   // as above but search ends if the terminate string is found
 
+  int findMulti(StreamMatcher &matcher);   // reads data from the stream until one of the matcher's patterns is found
+  // returns the number of the pattern found, -1 if timed out
+
 
   long parseInt(); // returns the first valid (long) integer value from the current position.
   // initial characters that are not digits (or the minus sign) are skipped
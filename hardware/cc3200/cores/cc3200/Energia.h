@@ -8,6 +8,8 @@
 #include <string.h> 
 #include <math.h>
 #include <itoa.h>
+#include "profile.h"
+#include "pingroup.h"
 
 #include "inc/hw_types.h"  		
 #include "inc/hw_nvic.h" 
@@ -108,6 +110,8 @@ void loop(void);
 
 void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t val);
 uint8_t shiftIn(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder);
+void shiftOutBuffer(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, const uint8_t *buf, size_t len);
+void shiftInBuffer(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t *buf, size_t len);
 unsigned long pulseIn(uint8_t pin, uint8_t state, unsigned long timeout);
 void pinMode(uint8_t, uint8_t);
 void digitalWrite(uint8_t, uint8_t);
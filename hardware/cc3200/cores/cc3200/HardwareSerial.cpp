@@ -47,6 +47,7 @@
 #include "driverlib/uart.h"
 #include "driverlib/systick.h"
 #include "HardwareSerial.h"
+#include "ringspan.h"
 
 #define TX_BUFFER_EMPTY    (txReadIndex == txWriteIndex)
 #define TX_BUFFER_FULL     (((txWriteIndex + 1) % txBufferSize) == txReadIndex)
@@ -273,6 +274,8 @@ HardwareSerial::operator bool()
 
 size_t HardwareSerial::write(uint8_t c)
 {
+	PROFILE_DRIVER_SCOPE("serial.write");
+
 	unsigned int numTransmit = 0;
 
 	/* Check for valid arguments. */
@@ -296,8 +299,44 @@ size_t HardwareSerial::write(uint8_t c)
 	return numTransmit;
 }
 
+size_t HardwareSerial::readRegion(const uint8_t **data)
+{
+	*data = rxBuffer + rxReadIndex;
+	return ringReadSpan(rxReadIndex, rxWriteIndex, rxBufferSize);
+}
+
+void HardwareSerial::consume(size_t n)
+{
+	if (n > (size_t)available())
+		n = available();
+
+	rxReadIndex = (rxReadIndex + n) % rxBufferSize;
+}
+
+size_t HardwareSerial::writeRegion(uint8_t **data)
+{
+	*data = txBuffer + txWriteIndex;
+	return ringWriteSpan(txReadIndex, txWriteIndex, txBufferSize);
+}
+
+void HardwareSerial::commit(size_t n)
+{
+	uint8_t *data;
+
+	if (n > writeRegion(&data))
+		n = writeRegion(&data);
+
+	txWriteIndex = (txWriteIndex + n) % txBufferSize;
+
+	if(!TX_BUFFER_EMPTY) {
+		primeTransmit(UART_BASE);
+	}
+}
+
 void HardwareSerial::UARTIntHandler(void)
 {
+	PROFILE_DRIVER_SCOPE("serial.isr");
+
 	unsigned long ulInts;
 	long lChar;
 
@@ -70,6 +70,14 @@ class HardwareSerial : public Stream
 		virtual size_t write(uint8_t c);
 		operator bool();
 		using Print::write; // pull in write(str) and write(buf, size) from Print
+		/* Zero-copy access to the ring buffers. readRegion() returns the
+		 * contiguous run of received bytes, consume() releases them.
+		 * writeRegion() returns the contiguous free space of the transmit
+		 * buffer, commit() queues what was written there. */
+		size_t readRegion(const uint8_t **data);
+		void consume(size_t n);
+		size_t writeRegion(uint8_t **data);
+		void commit(size_t n);
 };
 
 extern HardwareSerial Serial;
@@ -0,0 +1,107 @@
+/*
+  StreamMatcher.cpp - Watches a stream of characters for several patterns
+  at once, used by Stream::find() and findUntil()
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "StreamMatcher.h"
+
+bool StreamMatcher::add(const char *pattern, size_t length)
+{
+  size_t i, k;
+
+  if (count >= STREAM_MATCH_TARGETS || !pattern || length == 0)
+    return false;
+
+  Target &t = target[count];
+
+  t.str = pattern;
+  t.len = length;
+  t.state = 0;
+  t.fail = NULL;
+
+  // prefix function: fail[i] is the longest proper border of str[0..i]
+  if (length <= 256 && used + length <= STREAM_MATCH_POOL) {
+    t.fail = pool + used;
+    used += length;
+    t.fail[0] = 0;
+    for (i = 1, k = 0; i < length; i++) {
+      while (k > 0 && pattern[i] != pattern[k])
+        k = t.fail[k - 1];
+      if (pattern[i] == pattern[k])
+        k++;
+      t.fail[i] = k;
+    }
+  }
+
+  count++;
+  return true;
+}
+
+void StreamMatcher::reset()
+{
+  for (unsigned char i = 0; i < count; i++)
+    target[i].state = 0;
+}
+
+// length of the longest proper border of the first q bytes of the pattern
+size_t StreamMatcher::border(const Target &t, size_t q)
+{
+  size_t b;
+
+  if (t.fail)
+    return t.fail[q - 1];
+  for (b = q - 1; b > 0; b--) {
+    if (memcmp(t.str, t.str + q - b, b) == 0)
+      break;
+  }
+  return b;
+}
+
+int StreamMatcher::match(char c)
+{
+  int found = -1;
+
+  for (unsigned char i = 0; i < count; i++) {
+    Target &t = target[i];
+    size_t q = t.state;
+
+    while (q > 0 && t.str[q] != c)
+      q = border(t, q);
+    if (t.str[q] == c)
+      q++;
+    t.state = q;
+    if (q == t.len && found < 0)
+      found = i;
+  }
+
+  if (found >= 0)
+    reset();
+  return found;
+}
+
+int StreamMatcher::match(const char *buffer, size_t length, size_t *consumed)
+{
+  size_t n;
+  int found = -1;
+
+  for (n = 0; n < length && found < 0; n++)
+    found = match(buffer[n]);
+
+  if (consumed)
+    *consumed = n;
+  return found;
+}
@@ -0,0 +1,105 @@
+/*
+  cotask.c - Cooperative tasks that wait without blocking, run from the main
+  loop and from delay()
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <stddef.h>
+#include "Energia.h"
+#include "cotask.h"
+
+// Sleeping in COTASK_SLEEP, not to be called before wake
+#define COTASK_SLEEPING   0x01
+
+static CoTask *coTaskList;
+static CoTask *coTaskCursor;    // next one coTaskRun() calls, kept valid by coTaskStop()
+static bool coTaskRunning;
+
+static CoTask **coTaskFind(const CoTask *task)
+{
+	CoTask **link;
+
+	for (link = &coTaskList; *link; link = &(*link)->next)
+		if (*link == task)
+			return link;
+	return NULL;
+}
+
+void coTaskStart(CoTask *task, CoTaskFunction function, void *arg)
+{
+	task->function = function;
+	task->arg = arg;
+	task->resume = 0;
+	task->flags = 0;
+	if (!coTaskFind(task)) {
+		task->next = coTaskList;
+		coTaskList = task;
+	}
+}
+
+void coTaskStop(CoTask *task)
+{
+	CoTask **link = coTaskFind(task);
+
+	if (!link)
+		return;
+	if (coTaskCursor == task)
+		coTaskCursor = task->next;
+	*link = task->next;
+}
+
+bool coTaskActive(const CoTask *task)
+{
+	return coTaskFind(task) != NULL;
+}
+
+void coTaskSleep(CoTask *task, unsigned long ms)
+{
+	coTaskTimeout(task, ms);
+	task->flags |= COTASK_SLEEPING;
+}
+
+void coTaskTimeout(CoTask *task, unsigned long ms)
+{
+	task->wake = millis() + ms;
+}
+
+bool coTaskTimedOut(const CoTask *task)
+{
+	return (long)(millis() - task->wake) >= 0;
+}
+
+void coTaskRun(void)
+{
+	CoTask *task;
+
+	if (coTaskRunning || !coTaskList)
+		return;
+
+	coTaskRunning = true;
+	coTaskCursor = coTaskList;
+	while ((task = coTaskCursor) != NULL) {
+		coTaskCursor = task->next;
+		if (task->flags & COTASK_SLEEPING) {
+			if (!coTaskTimedOut(task))
+				continue;
+			task->flags &= ~COTASK_SLEEPING;
+		}
+		if (task->function(task) == COTASK_DONE)
+			coTaskStop(task);
+	}
+	coTaskRunning = false;
+}
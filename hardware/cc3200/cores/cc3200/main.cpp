@@ -7,6 +7,8 @@
 #include <driverlib/utils.h>
 #include "inc/hw_hib1p2.h"
 #include "inc/hw_hib3p3.h"
+#include "wheeltimer.h"
+#include "cotask.h"
 
 extern void (* const g_pfnVectors[])(void);
 
@@ -25,10 +27,13 @@ int main(void)
 	MAP_SysTickPeriodSet(F_CPU / 1000);
 	MAP_SysTickEnable();
 
+	profileInit();
 	setup();
 
 	for (;;) {
 		loop();
 		if (serialEventRun) serialEventRun();
+		wheelTimerRun();
+		coTaskRun();
 	}
 }
@@ -0,0 +1,61 @@
+/*
+  numtostr.h - Integer and floating point to text conversion shared by
+  Print and String
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _NUMTOSTR_
+#define _NUMTOSTR_
+
+#include <stddef.h>
+#include <limits.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif // __cplusplus
+
+// Largest integer text: a long in base 2, a sign and the terminating zero
+#define NUMTOSTR_LONG_LEN       (CHAR_BIT * sizeof(long) + 2)
+
+// Fraction digits beyond this are not printed by dtostr()/ftostr()
+#define NUMTOSTR_FLOAT_DIGITS   16
+
+// Largest float text: sign, 10 integer digits, point, fraction, zero
+#define NUMTOSTR_FLOAT_LEN      (1 + 10 + 1 + NUMTOSTR_FLOAT_DIGITS + 1)
+
+/*
+ * All functions write a zero terminated string to buf and return its
+ * length. Bases from 2 to 36 are supported, anything else is taken as 10.
+ * Only base 10 gets a sign, other bases print the two's complement.
+ * upper selects 'A'-'Z' over 'a'-'z' for digits above 9.
+ */
+extern size_t ultostr( unsigned long value, char *buf, int base, int upper ) ;
+extern size_t ltostr( long value, char *buf, int base, int upper ) ;
+
+/*
+ * Fixed point with the given number of fraction digits, correctly rounded
+ * (ties to even) from the exact binary value. Values whose integer part
+ * does not fit 32 bits print as "ovf", not-a-numbers as "nan" and
+ * infinities as "inf".
+ */
+extern size_t dtostr( double value, char *buf, unsigned char digits ) ;
+extern size_t ftostr( float value, char *buf, unsigned char digits ) ;
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // __cplusplus
+
+#endif // _NUMTOSTR_
@@ -0,0 +1,106 @@
+/*
+  pingroup.c - Reading and writing several pins of one port in a single
+  register access
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "Energia.h"
+#include "wiring_fast.h"
+#include "pingroup.h"
+
+void portWrite(uint8_t port, uint8_t mask, uint8_t value)
+{
+	if (port == NOT_A_PORT)
+		return;
+	*GPIO_DATA_ALIAS(port_to_base[port], mask) = value;
+}
+
+uint8_t portRead(uint8_t port)
+{
+	if (port == NOT_A_PORT)
+		return 0;
+	return *GPIO_DATA_ALIAS(port_to_base[port], 0xFF);
+}
+
+bool pinGroupInit(PinGroup *group, const uint8_t *pins, uint8_t count)
+{
+	uint8_t port, bit, i;
+
+	group->port = NOT_A_PORT;
+	group->mask = 0;
+	group->shift = -1;
+	group->count = 0;
+
+	if (count == 0 || count > PINGROUP_MAX)
+		return false;
+
+	port = digitalPinToPort(pins[0]);
+	for (i = 0; i < count; i++) {
+		bit = digitalPinToBitMask(pins[i]);
+		if (port == NOT_A_PORT || digitalPinToPort(pins[i]) != port ||
+		    (group->mask & bit)) {
+			group->mask = 0;
+			return false;
+		}
+		group->bits[i] = bit;
+		group->mask |= bit;
+	}
+
+	// Port bits in the same order as the value bits need no mapping
+	for (i = 0; !(group->bits[0] & (1 << i)); i++)
+		;
+	group->shift = i;
+	for (i = 1; i < count; i++) {
+		if (group->bits[i] != (uint8_t)(group->bits[0] << i)) {
+			group->shift = -1;
+			break;
+		}
+	}
+
+	group->port = port;
+	group->count = count;
+	return true;
+}
+
+void pinGroupWrite(const PinGroup *group, uint8_t value)
+{
+	uint8_t bits = 0;
+	uint8_t i;
+
+	if (group->shift >= 0) {
+		bits = value << group->shift;
+	} else {
+		for (i = 0; i < group->count; i++)
+			if (value & (1 << i))
+				bits |= group->bits[i];
+	}
+	portWrite(group->port, group->mask, bits);
+}
+
+uint8_t pinGroupRead(const PinGroup *group)
+{
+	uint8_t bits = portRead(group->port) & group->mask;
+	uint8_t value = 0;
+	uint8_t i;
+
+	if (group->shift >= 0)
+		return bits >> group->shift;
+
+	for (i = 0; i < group->count; i++)
+		if (bits & group->bits[i])
+			value |= 1 << i;
+	return value;
+}
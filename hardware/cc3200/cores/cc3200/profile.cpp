@@ -0,0 +1,127 @@
+/*
+  profile.cpp - Cycle counting profiler zones on the Cortex-M4 DWT cycle
+  counter
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "Energia.h"
+#include "driverlib/rom_map.h"
+#include "driverlib/interrupt.h"
+#include "profile.h"
+
+static ProfileZone *profileZones;
+static uint32_t profileOverhead;    // what an empty zone measures
+
+void profileInit(void)
+{
+	uint32_t start;
+
+	PROFILE_DEMCR |= PROFILE_DEMCR_TRCENA;
+	PROFILE_DWT_CYCCNT = 0;
+	PROFILE_DWT_CTRL |= PROFILE_DWT_CYCCNTENA;
+
+	start = profileCycles();
+	profileOverhead = profileCycles() - start;
+}
+
+void profileAdd(ProfileZone *zone, uint32_t cycles)
+{
+	bool wasDisabled = MAP_IntMasterDisable();
+
+	cycles = cycles > profileOverhead ? cycles - profileOverhead : 0;
+	if (zone->count++ == 0 && !zone->next) {
+		zone->next = profileZones ? profileZones : zone;
+		profileZones = zone;
+	}
+	if (cycles < zone->min)
+		zone->min = cycles;
+	if (cycles > zone->max)
+		zone->max = cycles;
+	zone->total += cycles;
+
+	if (!wasDisabled)
+		MAP_IntMasterEnable();
+}
+
+/*
+ * The last zone in the list points at itself, so next is only NULL for
+ * zones not in the list yet.
+ */
+static ProfileZone *profileNext(ProfileZone *zone)
+{
+	return zone->next == zone ? NULL : zone->next;
+}
+
+void profileReset(void)
+{
+	ProfileZone *zone;
+	bool wasDisabled = MAP_IntMasterDisable();
+
+	for (zone = profileZones; zone; zone = profileNext(zone)) {
+		zone->count = 0;
+		zone->min = 0xFFFFFFFF;
+		zone->max = 0;
+		zone->total = 0;
+	}
+
+	if (!wasDisabled)
+		MAP_IntMasterEnable();
+}
+
+static void printCycles(uint64_t n)
+{
+	char buf[21];
+	char *str = &buf[sizeof(buf) - 1];
+
+	*str = '\0';
+	do {
+		*--str = '0' + n % 10;
+		n /= 10;
+	} while (n);
+	Serial.print(str);
+}
+
+void profileDump(void)
+{
+	ProfileZone *zone, copy;
+	bool wasDisabled;
+
+	Serial.print("#profile ");
+	Serial.println(F_CPU);
+
+	for (zone = profileZones; zone; zone = profileNext(zone)) {
+		// the counts as of one moment, interrupts may be adding to them
+		wasDisabled = MAP_IntMasterDisable();
+		copy = *zone;
+		if (!wasDisabled)
+			MAP_IntMasterEnable();
+
+		if (!copy.count)
+			continue;
+		Serial.print(copy.name);
+		Serial.print('\t');
+		Serial.print(copy.count);
+		Serial.print('\t');
+		Serial.print(copy.min);
+		Serial.print('\t');
+		Serial.print(copy.max);
+		Serial.print('\t');
+		printCycles(copy.total);
+		Serial.println();
+	}
+
+	Serial.println("#end");
+}
@@ -0,0 +1,209 @@
+/*
+  wheeltimer.c - Software timers on a hierarchical timer wheel, ticked by
+  SysTick every millisecond
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <stddef.h>
+#include "Energia.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/systick.h"
+#include "wheeltimer.h"
+
+/*
+ * Four levels of 64 slots. Level 0 holds the timers due in the next 64
+ * ticks, one slot per tick; level n those due within 64^(n+1) ticks, one
+ * slot per 64^n. Each time level n wraps, the next slot of level n+1 is
+ * spread over the levels below. Timers further out than the top level
+ * reaches (about 4.6 hours) are parked in its last slot and placed again
+ * when it comes round.
+ */
+#define WHEEL_BITS      6
+#define WHEEL_SIZE      (1 << WHEEL_BITS)
+#define WHEEL_MASK      (WHEEL_SIZE - 1)
+#define WHEEL_LEVELS    4
+#define WHEEL_SPAN      ((1UL << (WHEEL_BITS * WHEEL_LEVELS)) - 1)
+
+static WheelTimer *wheel[WHEEL_LEVELS][WHEEL_SIZE];
+static uint32_t wheelNext;              // tick the wheel will process next
+static unsigned long wheelCount;        // timers started
+static WheelTimer *volatile deferList;   // timers owed a wheelTimerRun()
+
+// SysTick keeps interrupting for millis(), nothing to switch off
+static void wheelIdle(bool idle)
+{
+	(void)idle;
+}
+
+static void wheelAdd(WheelTimer *timer)
+{
+	uint32_t expires = timer->expires;
+	uint32_t delta = expires - wheelNext;
+	WheelTimer **slot;
+	unsigned int level;
+
+	if ((int32_t)delta < 0) {
+		// overdue, run on the next tick
+		slot = &wheel[0][wheelNext & WHEEL_MASK];
+	} else {
+		if (delta > WHEEL_SPAN) {
+			expires = wheelNext + WHEEL_SPAN;
+			delta = WHEEL_SPAN;
+		}
+		for (level = 0; delta >> (WHEEL_BITS * (level + 1)); level++)
+			;
+		slot = &wheel[level][(expires >> (WHEEL_BITS * level)) & WHEEL_MASK];
+	}
+
+	timer->next = *slot;
+	if (timer->next)
+		timer->next->pprev = &timer->next;
+	*slot = timer;
+	timer->pprev = slot;
+}
+
+static void wheelRemove(WheelTimer *timer)
+{
+	*timer->pprev = timer->next;
+	if (timer->next)
+		timer->next->pprev = timer->pprev;
+	timer->pprev = NULL;
+}
+
+// Spread the current slot of a level over the levels below, returns the
+// slot index so the caller knows whether this level wrapped as well
+static unsigned int wheelCascade(unsigned int level)
+{
+	unsigned int index = (wheelNext >> (WHEEL_BITS * level)) & WHEEL_MASK;
+	WheelTimer *timer = wheel[level][index], *next;
+
+	wheel[level][index] = NULL;
+	for (; timer; timer = next) {
+		next = timer->next;
+		wheelAdd(timer);
+	}
+	return index;
+}
+
+void wheelTimerInit(WheelTimer *timer, WheelTimerCallback callback, void *arg,
+                   uint8_t flags)
+{
+	timer->next = NULL;
+	timer->pprev = NULL;
+	timer->deferNext = NULL;
+	timer->callback = callback;
+	timer->arg = arg;
+	timer->flags = flags;
+	timer->deferred = 0;
+}
+
+void wheelTimerStart(WheelTimer *timer, uint32_t ms, uint32_t period)
+{
+	bool wasDisabled = MAP_IntMasterDisable();
+
+	if (timer->pprev)
+		wheelRemove(timer);
+	else if (wheelCount++ == 0)
+		wheelIdle(false);
+	timer->expires = wheelNext + ms;
+	timer->period = period;
+	wheelAdd(timer);
+
+	if (!wasDisabled)
+		MAP_IntMasterEnable();
+}
+
+void wheelTimerStop(WheelTimer *timer)
+{
+	bool wasDisabled = MAP_IntMasterDisable();
+
+	if (timer->pprev) {
+		wheelRemove(timer);
+		if (--wheelCount == 0)
+			wheelIdle(true);
+	}
+
+	if (!wasDisabled)
+		MAP_IntMasterEnable();
+}
+
+bool wheelTimerActive(const WheelTimer *timer)
+{
+	return timer->pprev != NULL;
+}
+
+void wheelTimerTick(void)
+{
+	unsigned int index = wheelNext & WHEEL_MASK;
+	unsigned int level;
+	WheelTimer *work, *timer;
+
+	for (level = 1; index == 0 && level < WHEEL_LEVELS; level++) {
+		if (wheelCascade(level) != 0)
+			break;
+	}
+
+	// Take the slot out of the wheel, so the callbacks can start and stop
+	// timers (the ones in it included) freely
+	work = wheel[0][index];
+	wheel[0][index] = NULL;
+	if (work)
+		work->pprev = &work;
+	wheelNext++;
+
+	while ((timer = work) != NULL) {
+		wheelRemove(timer);
+		if (timer->period) {
+			timer->expires += timer->period;
+			wheelAdd(timer);
+		} else if (--wheelCount == 0) {
+			wheelIdle(true);
+		}
+
+		if (timer->flags & WHEELTIMER_DEFER) {
+			if (timer->deferred++ == 0) {
+				timer->deferNext = deferList;
+				deferList = timer;
+			}
+		} else {
+			timer->callback(timer->arg);
+		}
+	}
+}
+
+void wheelTimerRun(void)
+{
+	WheelTimer *timer, *next;
+	uint8_t runs;
+
+	if (!deferList)
+		return;
+
+	MAP_IntMasterDisable();
+	timer = deferList;
+	deferList = NULL;
+	MAP_IntMasterEnable();
+
+	for (; timer; timer = next) {
+		MAP_IntMasterDisable();
+		next = timer->deferNext;
+		runs = timer->deferred;
+		timer->deferred = 0;
+		MAP_IntMasterEnable();
+		while (runs--)
+			timer->callback(timer->arg);
+	}
+}
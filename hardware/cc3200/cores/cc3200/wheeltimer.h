@@ -0,0 +1,77 @@
+/*
+  wheeltimer.h - Software timers on a hierarchical timer wheel, ticked by
+  SysTick every millisecond
+
+  Not included by Energia.h; #include "wheeltimer.h" to use the timers.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _WHEELTIMER_
+#define _WHEELTIMER_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif // __cplusplus
+
+typedef void (*WheelTimerCallback)(void *arg);
+
+// Run the callback from wheelTimerRun(), called after every loop(),
+// instead of from the SysTick interrupt
+#define WHEELTIMER_DEFER     0x01
+
+/*
+ * The caller owns the storage; a timer must stay valid (e.g. static or a
+ * class member) while it is started. The fields are private.
+ */
+typedef struct WheelTimer {
+	struct WheelTimer *next;       // in a wheel slot
+	struct WheelTimer **pprev;     // what points to this one, NULL if stopped
+	struct WheelTimer *deferNext;  // in the list for wheelTimerRun()
+	uint32_t expires;             // tick it is due at
+	uint32_t period;              // ticks between runs, 0 for one-shot
+	WheelTimerCallback callback;
+	void *arg;
+	uint8_t flags;
+	volatile uint8_t deferred;    // runs owed to wheelTimerRun()
+} WheelTimer;
+
+/*
+ * Starting and stopping take constant time whatever the number of timers.
+ * Times are in milliseconds: a timer runs at the first tick at least ms
+ * after it was started (one tick may already be partly gone), then every
+ * period ms if period is not 0. Starting a started timer restarts it.
+ * All can be called from interrupts and from the callbacks themselves.
+ */
+void wheelTimerInit(WheelTimer *timer, WheelTimerCallback callback, void *arg,
+                   uint8_t flags);
+void wheelTimerStart(WheelTimer *timer, uint32_t ms, uint32_t period);
+void wheelTimerStop(WheelTimer *timer);
+bool wheelTimerActive(const WheelTimer *timer);
+
+// Runs the callbacks of WHEELTIMER_DEFER timers that are due
+void wheelTimerRun(void);
+
+// Advances the wheel by one tick, from the SysTick interrupt
+void wheelTimerTick(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // __cplusplus
+
+#endif // _WHEELTIMER_
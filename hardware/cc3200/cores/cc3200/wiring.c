@@ -30,16 +30,16 @@
  */
 
 #include "Energia.h"
+#include "wiring_private.h"
 #include "inc/hw_ints.h"
 #include "inc/hw_timer.h"
 #include "driverlib/rom_map.h"
 #include "driverlib/systick.h"
 #include "driverlib/timer.h"
+#include "wheeltimer.h"
+#include "cotask.h"
 
-static void (*SysTickCbFuncs[8])(uint32_t ui32TimeMS);
-
-#define SYSTICKMS               (1000 / SYSTICKHZ)
-#define SYSTICKHZ               100
+#define SYSTICKCBMS             10
 
 static unsigned long milliseconds = 0;
 #define SYSTICK_INT_PRIORITY    0x80
@@ -68,17 +68,40 @@ void delayMicroseconds(unsigned int us)
 void delay(uint32_t millis)
 {
 	unsigned long i;
+	// no tasks from a handler, it may have interrupted one of them
+	int tasks = !currentException();
+
 	for(i=0; i<millis; i++){
 		delayMicroseconds(1000);
+		if(tasks)
+			coTaskRun();
 	}
 }
 
+//
+// The old fixed table of SysTick callbacks, now periodic software timers
+// calling back every SYSTICKCBMS
+//
+static struct {
+	WheelTimer timer;
+	void (*func)(uint32_t ui32TimeMS);
+} SysTickCbs[8];
+
+static void SysTickCbRun(void *arg)
+{
+	SysTickCbs[(uintptr_t)arg].func(SYSTICKCBMS);
+}
+
 void registerSysTickCb(void (*userFunc)(uint32_t))
 {
-	uint8_t i;
+	uintptr_t i;
 	for (i=0; i<8; i++) {
-		if(!SysTickCbFuncs[i]) {
-			SysTickCbFuncs[i] = userFunc;
+		if(SysTickCbs[i].func == userFunc)
+			break;
+		if(!SysTickCbs[i].func) {
+			SysTickCbs[i].func = userFunc;
+			wheelTimerInit(&SysTickCbs[i].timer, SysTickCbRun, (void *)i, 0);
+			wheelTimerStart(&SysTickCbs[i].timer, SYSTICKCBMS, SYSTICKCBMS);
 			break;
 		}
 	}
@@ -87,10 +110,5 @@ void registerSysTickCb(void (*userFunc)(uint32_t))
 void SysTickIntHandler(void)
 {
 	milliseconds++;
-
-	uint8_t i;
-	for (i=0; i<8; i++) {
-		if (SysTickCbFuncs[i])
-			SysTickCbFuncs[i](SYSTICKMS);
-	}
+	wheelTimerTick();
 }
@@ -0,0 +1,63 @@
+/*
+  wiring_fast.h - Single register GPIO accesses through the DATA alias,
+  shared by the pin group and buffered shift code
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef wiring_fast_h
+#define wiring_fast_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Energia.h"
+#include "inc/hw_gpio.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*
+ * Address bits 9:2 of a GPIO DATA access mask the pins it touches: a
+ * store changes only the pins in bits, a load reads only those pins and
+ * gives 0 for the others.
+ */
+#define GPIO_DATA_ALIAS(base, bits) \
+	((volatile uint32_t *)((base) + GPIO_O_GPIO_DATA + ((bits) << 2)))
+
+// The DATA alias of a single pin, NULL if it is not a GPIO
+static inline volatile uint32_t *digitalPinToDataAlias(uint8_t pin)
+{
+	uint8_t port = digitalPinToPort(pin);
+
+	if (port == NOT_A_PORT)
+		return NULL;
+	return GPIO_DATA_ALIAS(port_to_base[port], digitalPinToBitMask(pin));
+}
+
+// Bit 0 to bit 7 and back, for LSB first transfers
+static inline uint8_t reverseByte(uint8_t val)
+{
+	uint32_t r = val;
+
+	__asm volatile ("rbit %0, %1" : "=r" (r) : "r" (r));
+	return r >> 24;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif
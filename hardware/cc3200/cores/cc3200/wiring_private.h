@@ -48,6 +48,14 @@ void GPIOIntHandler(void);
 
 typedef void (*voidFuncPtr)(void);
 
+// Number of the exception being handled, 0 in thread mode
+static inline uint32_t currentException(void)
+{
+    uint32_t ipsr;
+    __asm volatile ("mrs %0, ipsr" : "=r" (ipsr));
+    return ipsr & 0x1FF;
+}
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
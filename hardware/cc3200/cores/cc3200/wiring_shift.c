@@ -31,6 +31,7 @@
  */
 
 #include "wiring_private.h"
+#include "wiring_fast.h"
 
 uint8_t shiftIn(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder) {
     uint8_t value = 0;
@@ -61,3 +62,51 @@ void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t val)
         digitalWrite(clockPin, LOW);
     }
 }
+
+/*
+ * The GSPI belongs to the SPI library, so these bit-bang, one store per
+ * edge instead of a digitalWrite() each
+ */
+void shiftOutBuffer(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder,
+                    const uint8_t *buf, size_t len)
+{
+    volatile uint32_t *data = digitalPinToDataAlias(dataPin);
+    volatile uint32_t *clock = digitalPinToDataAlias(clockPin);
+    uint8_t val, i;
+
+    if (!data || !clock)
+        return;
+
+    while (len--) {
+        val = *buf++;
+        if (bitOrder == LSBFIRST)
+            val = reverseByte(val);
+        for (i = 0; i < 8; i++) {
+            *data = (val & 0x80) ? 0xFF : 0;
+            *clock = 0xFF;
+            *clock = 0;
+            val <<= 1;
+        }
+    }
+}
+
+void shiftInBuffer(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder,
+                   uint8_t *buf, size_t len)
+{
+    volatile uint32_t *data = digitalPinToDataAlias(dataPin);
+    volatile uint32_t *clock = digitalPinToDataAlias(clockPin);
+    uint8_t val, i;
+
+    if (!data || !clock)
+        return;
+
+    while (len--) {
+        val = 0;
+        for (i = 0; i < 8; i++) {
+            *clock = 0xFF;
+            val = (val << 1) | (*data ? 1 : 0);
+            *clock = 0;
+        }
+        *buf++ = bitOrder == LSBFIRST ? reverseByte(val) : val;
+    }
+}
@@ -158,33 +158,55 @@ void A110x2500Radio::transmit(uint8_t address,
   }
 }
 
+boolean A110x2500Radio::receiverStart(uint8_t *dataField, uint8_t length)
+{
+  if (busy())
+  {
+    return false;
+  }
+
+  // Bring the radio out of a low power state.
+  wakeup();
+
+  // Set the receive buffer.
+  Radio._dataStream.length = 0;
+  Radio._dataStream.address = 0;
+  Radio._dataStream.dataField = dataField;
+
+  // Listen for a data stream.
+  CC1101Idle(&gPhyInfo.cc1101);
+  CC1101FlushRxFifo(&gPhyInfo.cc1101);
+  CC1101ReceiverOn(&gPhyInfo.cc1101);
+
+  return true;
+}
+
+int A110x2500Radio::receiverPoll()
+{
+  if (!gDataReceived)
+  {
+    return -1;
+  }
+
+  gDataReceived = false;
+  return Radio._dataStream.length;
+}
+
 unsigned char A110x2500Radio::receiverOn(uint8_t *dataField,
 																				 uint8_t length,
 																				 uint16_t timeout)
 {
-  if (!busy())
-  {
-    // Bring the radio out of a low power state.
-    wakeup();
-    
-    // Set the receive buffer.
-    Radio._dataStream.length = 0;
-    Radio._dataStream.address = 0;
-    Radio._dataStream.dataField = dataField;
+  int received;
 
-    // Listen for a data stream.
-    CC1101Idle(&gPhyInfo.cc1101);
-    CC1101FlushRxFifo(&gPhyInfo.cc1101);
-    CC1101ReceiverOn(&gPhyInfo.cc1101);
-    
+  if (receiverStart(dataField, length))
+  {
     // Listen for at most the timeout period or until a message is received.
     while (timeout-- > 0)
     {
       delay(1);
-      if (gDataReceived)
+      if ((received = receiverPoll()) >= 0)
       {
-        gDataReceived = false;
-        return Radio._dataStream.length;
+        return received;
       }
     }
   }
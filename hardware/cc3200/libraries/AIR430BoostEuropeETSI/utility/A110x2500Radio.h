@@ -167,6 +167,28 @@ public:
    */
   static void transmit(uint8_t address, uint8_t *dataField, uint8_t length);
 
+  /**
+   *  receiverStart - turn on the radio receiver and return immediately. Call
+   *  receiverPoll() (e.g. from a task) to find out when a message arrived.
+   *
+   *    @param	dataField   Buffer that stores the data field. It must stay
+   *                        valid until a message has been received.
+   *	  @param	length      Size of the data field buffer in bytes.
+   *
+   *    @return	True if the receiver was turned on; false if the transmitter
+   *            is still busy.
+   */
+  static boolean receiverStart(uint8_t *dataField, uint8_t length);
+
+  /**
+   *  receiverPoll - check for a message since receiverStart() without
+   *  waiting.
+   *
+   *    @return	Number of bytes copied into the data field, or -1 if no
+   *            message has been received yet.
+   */
+  static int receiverPoll(void);
+
   /**
    *  receiverOn - turn on the radio receiver and listen until a timeout occurs.
    *  
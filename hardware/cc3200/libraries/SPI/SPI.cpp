@@ -132,6 +132,8 @@ void SPIClass::setClockDivider(uint8_t divider)
 
 uint8_t SPIClass::transfer(uint8_t data)
 {
+	PROFILE_DRIVER_SCOPE("spi.transfer");
+
 	uint32_t rxtxData;
 	uint8_t rxData;
 
@@ -100,6 +100,8 @@ uint8_t TwoWire::I2CTransact(unsigned long ulCmd)
 
 uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop)
 {
+	PROFILE_DRIVER_SCOPE("wire.requestFrom");
+
 	if (!quantity) return 0;
 
 	uint8_t oldWriteIndex = rxWriteIndex;
@@ -156,6 +158,8 @@ uint8_t TwoWire::requestFrom(int address, int quantity, int sendStop)
 
 uint8_t TwoWire::endTransmission(uint8_t sendStop)
 {
+	PROFILE_DRIVER_SCOPE("wire.endTransmission");
+
 	uint8_t error = I2C_MASTER_ERR_NONE;
 
 	if(TX_BUFFER_EMPTY) return 0;
@@ -6,6 +6,8 @@
 #include <string.h> 
 #include <math.h>
 #include "itoa.h"
+#include "profile.h"
+#include "pingroup.h"
 #include "part.h"
 
 #if defined(__TM4C129XNCZAD__)
@@ -220,7 +222,23 @@ void loop(void);
 
 void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t val);
 uint8_t shiftIn(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder);
+void shiftOutBuffer(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, const uint8_t *buf, size_t len);
+void shiftInBuffer(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t *buf, size_t len);
 unsigned long pulseIn(uint8_t pin, uint8_t state, unsigned long timeout);
+
+/*
+ * Measures a timer pin (digitalPinToTimer() != NOT_ON_TIMER) in the
+ * background with its timer's edge capture, up to four pins at once, one
+ * per timer half. pulseMeasureRead() gives the last high and low times in
+ * CPU cycles (period high + low, duty high / period, frequency
+ * F_CPU / period) and returns true once per new pair, false until then.
+ * A timer half that is already running, analogWrite() on it for one, and
+ * the Servo library's Timer2 are refused. pulseIn() uses the same capture
+ * where it can and times other pins in a loop as before.
+ */
+bool pulseMeasureBegin(uint8_t pin);
+bool pulseMeasureRead(uint8_t pin, uint32_t *high, uint32_t *low);
+void pulseMeasureEnd(uint8_t pin);
 void pinMode(uint8_t, uint8_t);
 void digitalWrite(uint8_t, uint8_t);
 int digitalRead(uint8_t);
@@ -229,6 +247,25 @@ void analogWrite(uint8_t, int);
 void analogReference(uint16_t);
 void analogFrequency(uint32_t);
 void analogResolution(uint16_t);
+uint8_t analogReadMulti(const uint8_t *pins, uint16_t *values, uint8_t count);
+void analogReadOversample(uint8_t factor);
+
+/*
+ * Samples up to eight pins rate times a second on ADC1, paced by a timer,
+ * with the uDMA filling buffer0 and buffer1 in turn, samples values each,
+ * interleaved pin by pin; samples must be a multiple of the pin count, and
+ * rate times the pin count may be up to 1000000.
+ * Each full block goes to callback from the interrupt, or with no callback
+ * is returned once by analogStreamRead(); a block not read before the next
+ * one fills counts as an overrun. A block is filled again once the other
+ * one is full, so it has to be dealt with by then.
+ */
+bool analogStreamBegin(const uint8_t *pins, uint8_t count, uint32_t rate,
+                       uint16_t *buffer0, uint16_t *buffer1, uint16_t samples,
+                       void (*callback)(uint16_t *block, uint16_t samples));
+uint16_t *analogStreamRead(void);
+unsigned long analogStreamOverruns(void);
+void analogStreamEnd(void);
 
 void delay(uint32_t milliseconds);
 void sleep(uint32_t milliseconds);
@@ -240,6 +277,30 @@ extern volatile boolean stay_asleep;
 void attachInterrupt(uint8_t, void (*)(void), int mode);
 void detachInterrupt(uint8_t);
 
+/*
+ * Edge capture: attachCapture(pin, RISING, FALLING or CHANGE) makes the
+ * port interrupt queue each edge with its DWT cycle count (profileCycles())
+ * instead of calling a function; captureRead() takes up to max of them out
+ * of the queue, oldest first, from the main loop. detachInterrupt() stops
+ * it. The edge is the level of the pin when the interrupt ran, so of two
+ * edges closer than the interrupt latency only the last is right. Edges
+ * that find the queue full are counted by captureOverflows().
+ */
+#ifndef CAPTURE_BUFFER_SIZE
+#define CAPTURE_BUFFER_SIZE 64  // a power of two
+#endif
+
+typedef struct EdgeEvent {
+	uint32_t cycles;
+	uint8_t pin;
+	uint8_t edge;   // RISING or FALLING
+} EdgeEvent;
+
+void attachCapture(uint8_t pin, int mode);
+int captureRead(EdgeEvent *events, int max);
+int captureAvailable(void);
+unsigned long captureOverflows(void);
+
 extern const uint8_t digital_pin_to_timer[];
 extern const uint8_t digital_pin_to_port[];
 extern const uint8_t digital_pin_to_bit_mask[];
@@ -297,6 +358,8 @@ extern const uint32_t digital_pin_to_analog_in[];
 void delayMicroseconds(unsigned int us);
 unsigned long micros();
 unsigned long millis();
+uint64_t micros64();
+uint64_t nanos();
 void timerInit();
 void registerSysTickCb(void (*userFunc)(uint32_t));
 #ifdef __cplusplus
@@ -328,6 +391,7 @@ long map(long, long, long, long, long);
 #endif
 
 #include "pins_energia.h"
+#include "wiring_fast.h"
 
 #endif
 
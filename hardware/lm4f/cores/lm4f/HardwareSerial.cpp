@@ -41,6 +41,7 @@
 #include "inc/hw_memmap.h"
 #include "inc/hw_types.h"
 #include "inc/hw_ints.h"
+#include "inc/hw_gpio.h"
 #include "inc/hw_uart.h"
 #include "driverlib/gpio.h"
 #include "driverlib/debug.h"
@@ -50,16 +51,37 @@
 #include "driverlib/pin_map.h"
 #include "driverlib/sysctl.h"
 #include "driverlib/uart.h"
+#include "driverlib/udma.h"
+#include "udma_if.h"
 #include "HardwareSerial.h"
+#include "ringspan.h"
 
+//
+// The ring buffer indices run freely and are masked on access; the buffer
+// sizes are always a power of two. Only the producer moves a write index and
+// only the consumer moves a read index, so neither side needs to lock.
+//
+#define TX_BUFFER_USED     (txWriteIndex - txReadIndex)
 #define TX_BUFFER_EMPTY    (txReadIndex == txWriteIndex)
-#define TX_BUFFER_FULL     (((txWriteIndex + 1) % txBufferSize) == txReadIndex)
+#define TX_BUFFER_FULL     (TX_BUFFER_USED == txBufferSize)
+#define TX_BUFFER_MASK     (txBufferSize - 1)
 
+#define RX_BUFFER_USED     (rxWriteIndex - rxReadIndex)
 #define RX_BUFFER_EMPTY    (rxReadIndex == rxWriteIndex)
-#define RX_BUFFER_FULL     (((rxWriteIndex + 1) % rxBufferSize) == rxReadIndex)
+#define RX_BUFFER_FULL     (RX_BUFFER_USED == rxBufferSize)
+#define RX_BUFFER_MASK     (rxBufferSize - 1)
 
 #define UART_BASE g_ulUARTBase[uartModule]
 
+#define DMA_RX_CHANNEL (g_ulUARTDMAChannel[uartModule][0] & 0xFF)
+#define DMA_TX_CHANNEL (g_ulUARTDMAChannel[uartModule][1] & 0xFF)
+
+//
+// One bit per UART module, set by the interrupt handler when it stored
+// received data, cleared by serialEventRun().
+//
+static volatile unsigned long g_ulSerialEvents;
+
 static const unsigned long g_ulUARTBase[8] =
 {
     UART0_BASE, UART1_BASE, UART2_BASE, UART3_BASE,
@@ -116,6 +138,19 @@ static const unsigned long g_ulUARTConfig[8][2] =
 #endif
 };
 
+//*****************************************************************************
+//
+// The uDMA channel assignments (RX, TX) for each UART.
+//
+//*****************************************************************************
+static const unsigned long g_ulUARTDMAChannel[8][2] =
+{
+    {UDMA_CH8_UART0RX, UDMA_CH9_UART0TX}, {UDMA_CH22_UART1RX, UDMA_CH23_UART1TX},
+    {UDMA_CH12_UART2RX, UDMA_CH13_UART2TX}, {UDMA_CH16_UART3RX, UDMA_CH17_UART3TX},
+    {UDMA_CH18_UART4RX, UDMA_CH19_UART4TX}, {UDMA_CH6_UART5RX, UDMA_CH7_UART5TX},
+    {UDMA_CH10_UART6RX, UDMA_CH11_UART6TX}, {UDMA_CH20_UART7RX, UDMA_CH21_UART7TX}
+};
+
 static const unsigned long g_ulUARTPort[8] =
 {
 #if defined(PART_TM4C1233H6PM) || defined(PART_LM4F120H5QR)
@@ -154,6 +189,65 @@ static const unsigned long g_ulUARTPins[8] =
 #endif
 };
 
+//*****************************************************************************
+//
+// The RTS and CTS pins of the UARTs with hardware flow control, 0 for none.
+//
+//*****************************************************************************
+static const unsigned long g_ulUARTFlowConfig[8][2] =
+{
+#if defined(PART_TM4C1233H6PM) || defined(PART_LM4F120H5QR)
+    {0, 0}, {GPIO_PF0_U1RTS, GPIO_PF1_U1CTS}, {0, 0}, {0, 0},
+    {0, 0}, {0, 0}, {0, 0}, {0, 0}
+#elif defined(PART_TM4C129XNCZAD)
+    {GPIO_PH0_U0RTS, GPIO_PH1_U0CTS}, {GPIO_PN0_U1RTS, GPIO_PN1_U1CTS},
+    {GPIO_PD6_U2RTS, GPIO_PD7_U2CTS}, {GPIO_PJ4_U3RTS, GPIO_PJ5_U3CTS},
+    {GPIO_PK2_U4RTS, GPIO_PK3_U4CTS}, {0, 0}, {0, 0}, {0, 0}
+#elif defined(PART_TM4C1294NCPDT)
+    {GPIO_PH0_U0RTS, GPIO_PH1_U0CTS}, {GPIO_PE0_U1RTS, GPIO_PP3_U1CTS},
+    {GPIO_PD6_U2RTS, GPIO_PD7_U2CTS}, {GPIO_PP4_U3RTS, GPIO_PP5_U3CTS},
+    {GPIO_PK2_U4RTS, GPIO_PK3_U4CTS}, {0, 0}, {0, 0}, {0, 0}
+#else
+#error "**** No PART defined or unsupported PART ****"
+#endif
+};
+
+static const unsigned long g_ulUARTFlowPort[8][2] =
+{
+#if defined(PART_TM4C1233H6PM) || defined(PART_LM4F120H5QR)
+    {0, 0}, {GPIO_PORTF_BASE, GPIO_PORTF_BASE}, {0, 0}, {0, 0},
+    {0, 0}, {0, 0}, {0, 0}, {0, 0}
+#elif defined(PART_TM4C129XNCZAD)
+    {GPIO_PORTH_BASE, GPIO_PORTH_BASE}, {GPIO_PORTN_BASE, GPIO_PORTN_BASE},
+    {GPIO_PORTD_BASE, GPIO_PORTD_BASE}, {GPIO_PORTJ_BASE, GPIO_PORTJ_BASE},
+    {GPIO_PORTK_BASE, GPIO_PORTK_BASE}, {0, 0}, {0, 0}, {0, 0}
+#elif defined(PART_TM4C1294NCPDT)
+    {GPIO_PORTH_BASE, GPIO_PORTH_BASE}, {GPIO_PORTE_BASE, GPIO_PORTP_BASE},
+    {GPIO_PORTD_BASE, GPIO_PORTD_BASE}, {GPIO_PORTP_BASE, GPIO_PORTP_BASE},
+    {GPIO_PORTK_BASE, GPIO_PORTK_BASE}, {0, 0}, {0, 0}, {0, 0}
+#else
+#error "**** No PART defined or unsupported PART ****"
+#endif
+};
+
+static const unsigned long g_ulUARTFlowPins[8][2] =
+{
+#if defined(PART_TM4C1233H6PM) || defined(PART_LM4F120H5QR)
+    {0, 0}, {GPIO_PIN_0, GPIO_PIN_1}, {0, 0}, {0, 0},
+    {0, 0}, {0, 0}, {0, 0}, {0, 0}
+#elif defined(PART_TM4C129XNCZAD)
+    {GPIO_PIN_0, GPIO_PIN_1}, {GPIO_PIN_0, GPIO_PIN_1},
+    {GPIO_PIN_6, GPIO_PIN_7}, {GPIO_PIN_4, GPIO_PIN_5},
+    {GPIO_PIN_2, GPIO_PIN_3}, {0, 0}, {0, 0}, {0, 0}
+#elif defined(PART_TM4C1294NCPDT)
+    {GPIO_PIN_0, GPIO_PIN_1}, {GPIO_PIN_0, GPIO_PIN_3},
+    {GPIO_PIN_6, GPIO_PIN_7}, {GPIO_PIN_4, GPIO_PIN_5},
+    {GPIO_PIN_2, GPIO_PIN_3}, {0, 0}, {0, 0}, {0, 0}
+#else
+#error "**** No PART defined or unsupported PART ****"
+#endif
+};
+
 // Constructors ////////////////////////////////////////////////////////////////
 HardwareSerial::HardwareSerial(void)
 {
@@ -167,6 +261,19 @@ HardwareSerial::HardwareSerial(void)
     rxBuffer = (unsigned char *) 0xFFFFFFFF;
     txBufferSize = SERIAL_BUFFER_SIZE;
     rxBufferSize = SERIAL_BUFFER_SIZE;
+
+    dmaMode = false;
+    rxDmaBuffer[0] = 0;
+    rxDmaBuffer[1] = 0;
+    txDmaCount = 0;
+
+    frameCallback = 0;
+    frameBuffer = 0;
+    frameIdle = false;
+
+    flowControl = false;
+    rxStalled = false;
+    memset(&stats, 0, sizeof(stats));
 }
 
 HardwareSerial::HardwareSerial(unsigned long module) 
@@ -181,6 +288,19 @@ HardwareSerial::HardwareSerial(unsigned long module)
     rxBuffer = (unsigned char *) 0xFFFFFFFF;
     txBufferSize = SERIAL_BUFFER_SIZE;
     rxBufferSize = SERIAL_BUFFER_SIZE;
+
+    dmaMode = false;
+    rxDmaBuffer[0] = 0;
+    rxDmaBuffer[1] = 0;
+    txDmaCount = 0;
+
+    frameCallback = 0;
+    frameBuffer = 0;
+    frameIdle = false;
+
+    flowControl = false;
+    rxStalled = false;
+    memset(&stats, 0, sizeof(stats));
 }
 // Private Methods //////////////////////////////////////////////////////////////
 void
@@ -198,40 +318,350 @@ HardwareSerial::flushAll(void)
     //
     rxReadIndex = 0;
     rxWriteIndex = 0;
+    rxStalled = false;
 }
 
 void
 HardwareSerial::primeTransmit(unsigned long ulBase)
 {
     //
-    // Do we have any data to transmit?
+    // Only ever called from the UART interrupt. Move as many characters out
+    // of the transmit buffer as the FIFO will take.
     //
-    if(!TX_BUFFER_EMPTY)
+    while(!TX_BUFFER_EMPTY && !(HWREG(ulBase + UART_O_FR) & UART_FR_TXFF))
+    {
+        HWREG(ulBase + UART_O_DR) = txBuffer[txReadIndex & TX_BUFFER_MASK];
+        txReadIndex++;
+    }
+
+    //
+    // Keep the transmit interrupt on for as long as there is data left.
+    //
+    if(TX_BUFFER_EMPTY)
+    {
+        ROM_UARTIntDisable(ulBase, UART_INT_TX);
+    }
+    else
+    {
+        ROM_UARTIntEnable(ulBase, UART_INT_TX);
+    }
+}
+
+void
+HardwareSerial::kickTransmit(void)
+{
+    //
+    // The FIFO is refilled from the interrupt only. If the interrupt is not
+    // already on its way (transmit interrupt armed or uDMA busy) pend it so
+    // that it picks up the data just queued. The interrupt handler cannot
+    // run half way through this check, so no locking is needed.
+    //
+    if(dmaMode ? (txDmaCount == 0) :
+       !(HWREG(UART_BASE + UART_O_IM) & UART_INT_TX))
+    {
+        ROM_IntPendSet(g_ulUARTInt[uartModule]);
+    }
+}
+
+void
+HardwareSerial::waitTransmitSpace(void)
+{
+    bool wasDisabled;
+
+    while(TX_BUFFER_FULL)
     {
         //
-        // Disable the UART interrupt. If we don't do this there is a race
-        // condition which can cause the read index to be corrupted.
-        //
-        ROM_IntDisable(g_ulUARTInt[uartModule]);
-        //
-        // Yes - take some characters out of the transmit buffer and feed
-        // them to the UART transmit FIFO.
+        // Space is freed by the UART interrupt. If it cannot run, because
+        // interrupts are masked or we are in a handler ourselves (a frame
+        // callback for one), drain the ring by hand.
         //
-        while(!TX_BUFFER_EMPTY)
+        if(!interruptsMasked() && !currentException())
         {
-            while(ROM_UARTSpaceAvail(ulBase) && !TX_BUFFER_EMPTY){
-                ROM_UARTCharPutNonBlocking(ulBase,
-                                       txBuffer[txReadIndex]);
+            continue;
+        }
 
-                txReadIndex = (txReadIndex + 1) % txBufferSize;
+        wasDisabled = ROM_IntMasterDisable();
+        if(dmaMode)
+        {
+            if(txDmaCount && !ROM_uDMAChannelIsEnabled(DMA_TX_CHANNEL))
+            {
+                txReadIndex += txDmaCount;
+                txDmaCount = 0;
             }
+            primeTransmitDMA();
+        }
+        else if(!(HWREG(UART_BASE + UART_O_FR) & UART_FR_TXFF))
+        {
+            HWREG(UART_BASE + UART_O_DR) = txBuffer[txReadIndex & TX_BUFFER_MASK];
+            txReadIndex++;
+        }
+        if(!wasDisabled)
+        {
+            ROM_IntMasterEnable();
         }
+    }
+}
 
+void
+HardwareSerial::primeTransmitDMA(void)
+{
+    unsigned long ulCount;
+
+    //
+    // Nothing to do if a transfer is already in flight or there is no data.
+    //
+    if(txDmaCount || TX_BUFFER_EMPTY)
+    {
+        return;
+    }
+
+    //
+    // Hand the contiguous part of the ring buffer straight to the uDMA. The
+    // remainder past the wrap is picked up by the completion interrupt.
+    //
+    ulCount = txBufferSize - (txReadIndex & TX_BUFFER_MASK);
+    if(ulCount > TX_BUFFER_USED)
+    {
+        ulCount = TX_BUFFER_USED;
+    }
+    if(ulCount > 1024)
+    {
+        ulCount = 1024;
+    }
+    txDmaCount = ulCount;
+
+    ROM_uDMAChannelTransferSet(DMA_TX_CHANNEL | UDMA_PRI_SELECT,
+                               UDMA_MODE_BASIC,
+                               txBuffer + (txReadIndex & TX_BUFFER_MASK),
+                               (void *)(UART_BASE + UART_O_DR), ulCount);
+    ROM_uDMAChannelEnable(DMA_TX_CHANNEL);
+}
+
+void
+HardwareSerial::frameEnd(void)
+{
+    //
+    // Hand the completed frame to the callback. Empty frames (back to back
+    // terminators, idle without data) are not reported.
+    //
+    if(frameCount)
+    {
+        frameCallback(frameBuffer, frameCount);
+        frameCount = 0;
+    }
+}
+
+inline void
+HardwareSerial::frameByte(unsigned char c)
+{
+    //
+    // The terminator ends the frame and is not part of it. A frame that
+    // reaches the frame length is complete as well.
+    //
+    if(c == frameTerminator)
+    {
+        frameEnd();
+        return;
+    }
+    frameBuffer[frameCount++] = c;
+    if(frameCount == frameLength)
+    {
+        frameEnd();
+    }
+}
+
+void
+HardwareSerial::rxBufferPut(const unsigned char *buf, unsigned long len)
+{
+    unsigned long ulFree, ulChunk;
+
+    if(frameCallback)
+    {
+        while(len--)
+        {
+            frameByte(*buf++);
+        }
+        return;
+    }
+
+    //
+    // If there is no space in the receive buffer, throw the rest away.
+    //
+    ulFree = rxBufferSize - RX_BUFFER_USED;
+    if(len > ulFree)
+    {
+        stats.dropped += len - ulFree;
+        len = ulFree;
+    }
+    if(len)
+    {
+        g_ulSerialEvents |= 1 << uartModule;
+    }
+
+    while(len)
+    {
+        ulChunk = rxBufferSize - (rxWriteIndex & RX_BUFFER_MASK);
+        if(ulChunk > len)
+        {
+            ulChunk = len;
+        }
+        memcpy(rxBuffer + (rxWriteIndex & RX_BUFFER_MASK), buf, ulChunk);
+        rxWriteIndex += ulChunk;
+        buf += ulChunk;
+        len -= ulChunk;
+    }
+
+    if(RX_BUFFER_USED > stats.rxPeak)
+    {
+        stats.rxPeak = RX_BUFFER_USED;
+    }
+}
+
+void
+HardwareSerial::receiveDMA(bool idle)
+{
+    unsigned long ulSelect, ulFilled;
+    unsigned char ucChar;
+
+    //
+    // Stop the UART from raising DMA requests while the FIFO is drained by
+    // hand, otherwise a burst could overtake the bytes being read here.
+    //
+    if(idle)
+    {
+        ROM_UARTDMADisable(UART_BASE, UART_DMA_RX);
+    }
+
+    //
+    // Move every completed ping-pong block into the receive buffer and
+    // re-arm it behind the one that is currently filling.
+    //
+    for(;;)
+    {
+        ulSelect = rxDmaActive ? UDMA_ALT_SELECT : UDMA_PRI_SELECT;
+        if(ROM_uDMAChannelModeGet(DMA_RX_CHANNEL | ulSelect) != UDMA_MODE_STOP)
+        {
+            break;
+        }
+        rxBufferPut(rxDmaBuffer[rxDmaActive] + rxDmaOffset,
+                    SERIAL_DMA_BLOCK_SIZE - rxDmaOffset);
+        ROM_uDMAChannelTransferSet(DMA_RX_CHANNEL | ulSelect,
+                                   UDMA_MODE_PINGPONG,
+                                   (void *)(UART_BASE + UART_O_DR),
+                                   rxDmaBuffer[rxDmaActive],
+                                   SERIAL_DMA_BLOCK_SIZE);
+        rxDmaOffset = 0;
+        rxDmaActive ^= 1;
+    }
+
+    //
+    // Both blocks filled before we got here; the channel stopped itself.
+    //
+    if(!ROM_uDMAChannelIsEnabled(DMA_RX_CHANNEL))
+    {
+        ROM_uDMAChannelEnable(DMA_RX_CHANNEL);
+    }
+
+    if(idle)
+    {
         //
-        // Reenable the UART interrupt.
+        // The line went idle: flush the partially filled block, then the
+        // bytes short of a full burst that are still sitting in the FIFO.
         //
-        ROM_IntEnable(g_ulUARTInt[uartModule]);
+        ulFilled = SERIAL_DMA_BLOCK_SIZE -
+            ROM_uDMAChannelSizeGet(DMA_RX_CHANNEL | ulSelect);
+        rxBufferPut(rxDmaBuffer[rxDmaActive] + rxDmaOffset,
+                    ulFilled - rxDmaOffset);
+        rxDmaOffset = ulFilled;
+
+        while(ROM_UARTCharsAvail(UART_BASE))
+        {
+            ucChar = ROM_UARTCharGetNonBlocking(UART_BASE);
+            rxBufferPut(&ucChar, 1);
+        }
+
+        if(frameIdle)
+        {
+            frameEnd();
+        }
+
+        ROM_UARTDMAEnable(UART_BASE, UART_DMA_RX);
+    }
+}
+
+void
+HardwareSerial::startDMA(void)
+{
+    if(rxDmaBuffer[0] == 0)
+    {
+        rxDmaBuffer[0] = (unsigned char *) malloc(2 * SERIAL_DMA_BLOCK_SIZE);
     }
+    rxDmaBuffer[1] = rxDmaBuffer[0] + SERIAL_DMA_BLOCK_SIZE;
+    rxDmaOffset = 0;
+    rxDmaActive = 0;
+    txDmaCount = 0;
+
+    ROM_uDMAChannelAssign(g_ulUARTDMAChannel[uartModule][0]);
+    ROM_uDMAChannelAssign(g_ulUARTDMAChannel[uartModule][1]);
+
+    //
+    // Receive into two ping-pong blocks. Only burst requests are serviced so
+    // that a partial burst stays in the FIFO and raises the receive timeout
+    // interrupt once the line goes idle.
+    //
+    ROM_uDMAChannelAttributeDisable(DMA_RX_CHANNEL, UDMA_ATTR_ALL);
+    ROM_uDMAChannelAttributeEnable(DMA_RX_CHANNEL, UDMA_ATTR_USEBURST);
+    ROM_uDMAChannelControlSet(DMA_RX_CHANNEL | UDMA_PRI_SELECT,
+                              UDMA_SIZE_8 | UDMA_SRC_INC_NONE |
+                              UDMA_DST_INC_8 | UDMA_ARB_8);
+    ROM_uDMAChannelControlSet(DMA_RX_CHANNEL | UDMA_ALT_SELECT,
+                              UDMA_SIZE_8 | UDMA_SRC_INC_NONE |
+                              UDMA_DST_INC_8 | UDMA_ARB_8);
+    ROM_uDMAChannelTransferSet(DMA_RX_CHANNEL | UDMA_PRI_SELECT,
+                               UDMA_MODE_PINGPONG,
+                               (void *)(UART_BASE + UART_O_DR),
+                               rxDmaBuffer[0], SERIAL_DMA_BLOCK_SIZE);
+    ROM_uDMAChannelTransferSet(DMA_RX_CHANNEL | UDMA_ALT_SELECT,
+                               UDMA_MODE_PINGPONG,
+                               (void *)(UART_BASE + UART_O_DR),
+                               rxDmaBuffer[1], SERIAL_DMA_BLOCK_SIZE);
+
+    //
+    // Transmit straight out of the ring buffer, see primeTransmitDMA().
+    //
+    ROM_uDMAChannelAttributeDisable(DMA_TX_CHANNEL, UDMA_ATTR_ALL);
+    ROM_uDMAChannelControlSet(DMA_TX_CHANNEL | UDMA_PRI_SELECT,
+                              UDMA_SIZE_8 | UDMA_SRC_INC_8 |
+                              UDMA_DST_INC_NONE | UDMA_ARB_4);
+
+    //
+    // A burst of 8 matches the RX FIFO trigger level; the DMA takes over
+    // the per character RX and TX interrupts.
+    //
+    ROM_UARTFIFOLevelSet(UART_BASE, UART_FIFO_TX4_8, UART_FIFO_RX4_8);
+    ROM_UARTIntDisable(UART_BASE, UART_INT_RX | UART_INT_TX);
+    //
+    // The uDMA only moves the data byte, so receive errors are picked up
+    // through their own interrupts.
+    //
+#ifdef TARGET_IS_SNOWFLAKE_RA0
+    ROM_UARTIntEnable(UART_BASE, UART_INT_RT | UART_INT_DMARX | UART_INT_DMATX |
+                      UART_INT_OE | UART_INT_BE | UART_INT_PE | UART_INT_FE);
+#else
+    ROM_UARTIntEnable(UART_BASE, UART_INT_RT |
+                      UART_INT_OE | UART_INT_BE | UART_INT_PE | UART_INT_FE);
+#endif
+    ROM_UARTDMAEnable(UART_BASE, UART_DMA_RX | UART_DMA_TX);
+    ROM_uDMAChannelEnable(DMA_RX_CHANNEL);
+}
+
+void
+HardwareSerial::stopDMA(void)
+{
+    ROM_UARTDMADisable(UART_BASE, UART_DMA_RX | UART_DMA_TX);
+    ROM_uDMAChannelDisable(DMA_RX_CHANNEL);
+    ROM_uDMAChannelDisable(DMA_TX_CHANNEL);
+    txDmaCount = 0;
 }
 
 // Public Methods //////////////////////////////////////////////////////////////
@@ -257,13 +687,20 @@ HardwareSerial::begin(unsigned long baud)
     //
     // Set the UART to interrupt whenever the TX FIFO is almost empty or
     // when any character is received.
+    // Idle line detection needs a deeper trigger level, see UARTIntHandler().
     //
-    ROM_UARTFIFOLevelSet(UART_BASE, UART_FIFO_TX1_8, UART_FIFO_RX1_8);
+    ROM_UARTFIFOLevelSet(UART_BASE, UART_FIFO_TX1_8,
+                         frameIdle ? UART_FIFO_RX4_8 : UART_FIFO_RX1_8);
     flushAll();
     ROM_UARTIntDisable(UART_BASE, 0xFFFFFFFF);
     ROM_UARTIntEnable(UART_BASE, UART_INT_RX | UART_INT_RT);
     ROM_IntEnable(g_ulUARTInt[uartModule]);
 
+    if(flowControl)
+    {
+        startFlowControl();
+    }
+
     //
     // Enable the UART operation.
     //
@@ -277,27 +714,245 @@ HardwareSerial::begin(unsigned long baud)
     txBuffer = (unsigned char *) malloc(txBufferSize);
     rxBuffer = (unsigned char *) malloc(rxBufferSize);
 
+    if(dmaMode)
+    {
+        startDMA();
+    }
+
     SysCtlDelay(100);
 }
 
+//
+// Round up to the next power of two so that ring indices can be masked.
+//
+static unsigned long
+roundUpPowerOfTwo(unsigned long size)
+{
+    size--;
+    size |= size >> 1;
+    size |= size >> 2;
+    size |= size >> 4;
+    size |= size >> 8;
+    size |= size >> 16;
+    return size + 1;
+}
+
 void
 HardwareSerial::setBufferSize(unsigned long txsize, unsigned long rxsize)
 {
     if (txsize > 0)
-        txBufferSize = txsize;
+        txBufferSize = roundUpPowerOfTwo(txsize);
     if (rxsize > 0)
-        rxBufferSize = rxsize;
+        rxBufferSize = roundUpPowerOfTwo(rxsize);
+}
+
+//
+// Move data between the UART and the buffers with the uDMA instead of the
+// CPU. Call before begin().
+//
+void
+HardwareSerial::setDMA(bool enable)
+{
+    if(enable)
+    {
+        UDMAInit();
+    }
+    dmaMode = enable;
 }
 
 void
 HardwareSerial::setModule(unsigned long module)
 {
+    if(dmaMode)
+    {
+        stopDMA();
+    }
     ROM_UARTIntDisable(UART_BASE, UART_INT_RX | UART_INT_RT);
     ROM_IntDisable(g_ulUARTInt[uartModule]);
 	uartModule = module;
 	begin(baudRate);
 
 }
+//
+// Assemble received bytes into frames in the interrupt handler and pass
+// each completed frame to the callback, still in interrupt context. A frame
+// ends at the terminator (if not -1), after length bytes, or when the line
+// goes idle (if idle is set). While a callback is attached received bytes
+// go to the frames only, not to the receive buffer.
+//
+void
+HardwareSerial::attachFrameCallback(SerialFrameCallback callback,
+                                    size_t length, int terminator, bool idle)
+{
+    unsigned char *buffer;
+
+    if(callback == 0 || length == 0)
+    {
+        return;
+    }
+
+    buffer = (unsigned char *) malloc(length);
+    if(buffer == 0)
+    {
+        return;
+    }
+
+    detachFrameCallback();
+
+    ROM_IntDisable(g_ulUARTInt[uartModule]);
+    frameBuffer = buffer;
+    frameLength = length;
+    frameCount = 0;
+    frameTerminator = terminator;
+    frameIdle = idle;
+    frameCallback = callback;
+
+    //
+    // Already running: switch to the trigger level idle detection needs.
+    //
+    if(txBuffer != (unsigned char *)0xFFFFFFFF)
+    {
+        if(idle && !dmaMode)
+        {
+            ROM_UARTFIFOLevelSet(UART_BASE, UART_FIFO_TX1_8, UART_FIFO_RX4_8);
+        }
+        ROM_IntEnable(g_ulUARTInt[uartModule]);
+    }
+}
+
+void
+HardwareSerial::detachFrameCallback(void)
+{
+    unsigned char *buffer = frameBuffer;
+
+    if(frameCallback == 0)
+    {
+        return;
+    }
+
+    ROM_IntDisable(g_ulUARTInt[uartModule]);
+    frameCallback = 0;
+    frameBuffer = 0;
+    if(txBuffer != (unsigned char *)0xFFFFFFFF)
+    {
+        if(frameIdle && !dmaMode)
+        {
+            ROM_UARTFIFOLevelSet(UART_BASE, UART_FIFO_TX1_8, UART_FIFO_RX1_8);
+        }
+        ROM_IntEnable(g_ulUARTInt[uartModule]);
+    }
+    frameIdle = false;
+    free(buffer);
+}
+
+void
+HardwareSerial::startFlowControl(void)
+{
+    unsigned long ulPort;
+    int i;
+
+    //
+    // Some flow control pins double as NMI or JTAG pins (PF0 on TM4C123,
+    // PD7 on TM4C129) whose function select is locked. Commit them, or the
+    // pin configuration below is silently ignored.
+    //
+    for(i = 0; i < 2; i++)
+    {
+        ulPort = g_ulUARTFlowPort[uartModule][i];
+        HWREG(ulPort + GPIO_O_LOCK) = GPIO_LOCK_KEY;
+        HWREG(ulPort + GPIO_O_CR) |= g_ulUARTFlowPins[uartModule][i];
+        HWREG(ulPort + GPIO_O_LOCK) = 0;
+    }
+
+    ROM_GPIOPinConfigure(g_ulUARTFlowConfig[uartModule][0]);
+    ROM_GPIOPinConfigure(g_ulUARTFlowConfig[uartModule][1]);
+    ROM_GPIOPinTypeUART(g_ulUARTFlowPort[uartModule][0],
+                        g_ulUARTFlowPins[uartModule][0]);
+    ROM_GPIOPinTypeUART(g_ulUARTFlowPort[uartModule][1],
+                        g_ulUARTFlowPins[uartModule][1]);
+    MAP_UARTFlowControlSet(UART_BASE,
+                           UART_FLOWCONTROL_RX | UART_FLOWCONTROL_TX);
+}
+
+//
+// Hardware RTS/CTS flow control. Returns false if the module has no flow
+// control pins. With flow control on, a full receive buffer holds the data
+// back in the FIFO, which deasserts RTS, instead of dropping it. In uDMA
+// mode flow control only protects the FIFO.
+//
+bool
+HardwareSerial::setFlowControl(bool enable)
+{
+    if(enable && g_ulUARTFlowConfig[uartModule][0] == 0)
+    {
+        return false;
+    }
+
+    flowControl = enable;
+
+    //
+    // Not started yet: begin() does the rest.
+    //
+    if(txBuffer == (unsigned char *)0xFFFFFFFF)
+    {
+        return true;
+    }
+
+    if(enable)
+    {
+        startFlowControl();
+    }
+    else
+    {
+        MAP_UARTFlowControlSet(UART_BASE, UART_FLOWCONTROL_NONE);
+        ROM_GPIOPinTypeGPIOInput(g_ulUARTFlowPort[uartModule][0],
+                                 g_ulUARTFlowPins[uartModule][0]);
+        ROM_GPIOPinTypeGPIOInput(g_ulUARTFlowPort[uartModule][1],
+                                 g_ulUARTFlowPins[uartModule][1]);
+        unstallReceive();
+    }
+    return true;
+}
+
+void
+HardwareSerial::unstallReceive(void)
+{
+    //
+    // The interrupt handler stopped reading the FIFO because the buffer was
+    // full. Let it look again now that there may be room.
+    //
+    if(rxStalled)
+    {
+        ROM_IntPendSet(g_ulUARTInt[uartModule]);
+    }
+}
+
+//
+// Snapshot of the receive error and buffer statistics since begin() or the
+// last clearStats().
+//
+void
+HardwareSerial::getStats(SerialStats *pStats)
+{
+    ROM_IntDisable(g_ulUARTInt[uartModule]);
+    *pStats = stats;
+    if(txBuffer != (unsigned char *)0xFFFFFFFF)
+    {
+        ROM_IntEnable(g_ulUARTInt[uartModule]);
+    }
+}
+
+void
+HardwareSerial::clearStats(void)
+{
+    ROM_IntDisable(g_ulUARTInt[uartModule]);
+    memset(&stats, 0, sizeof(stats));
+    if(txBuffer != (unsigned char *)0xFFFFFFFF)
+    {
+        ROM_IntEnable(g_ulUARTInt[uartModule]);
+    }
+}
+
 void 
 HardwareSerial::setPins(unsigned long pins)
 {
@@ -318,7 +973,14 @@ HardwareSerial::setPins(unsigned long pins)
 
 void HardwareSerial::end()
 {
-    unsigned long ulInt = ROM_IntMasterDisable();
+    unsigned long ulInt;
+
+    //
+    // Let any queued uDMA transmission finish while interrupts are still on.
+    //
+    flush();
+
+    ulInt = ROM_IntMasterDisable();
 
 	flushAll();
 
@@ -333,12 +995,15 @@ void HardwareSerial::end()
 
     ROM_IntDisable(g_ulUARTInt[uartModule]);
     ROM_UARTIntDisable(UART_BASE, UART_INT_RX | UART_INT_RT);
+    if(dmaMode)
+    {
+        stopDMA();
+    }
 }
 
 int HardwareSerial::available(void)
 {
-    return((rxWriteIndex >= rxReadIndex) ?
-		(rxWriteIndex - rxReadIndex) : rxBufferSize - (rxReadIndex - rxWriteIndex));
+    return(RX_BUFFER_USED);
 }
 
 int HardwareSerial::peek(void)
@@ -360,7 +1025,7 @@ int HardwareSerial::peek(void)
     //
     // Read a character from the buffer.
     //
-    cChar = rxBuffer[rxReadIndex];
+    cChar = rxBuffer[rxReadIndex & RX_BUFFER_MASK];
     //
     // Return the character to the caller.
     //
@@ -376,118 +1041,294 @@ int HardwareSerial::read(void)
     //
     // Read a character from the buffer.
     //
-    unsigned char cChar = rxBuffer[rxReadIndex];
-	rxReadIndex = ((rxReadIndex) + 1) % rxBufferSize;
+    unsigned char cChar = rxBuffer[rxReadIndex & RX_BUFFER_MASK];
+	rxReadIndex++;
+	unstallReceive();
 	return cChar;
 }
 
+int HardwareSerial::read(uint8_t *buffer, size_t size)
+{
+    size_t count = 0;
+    unsigned long ulChunk;
+
+    //
+    // Copy whatever is buffered, in at most two spans as the ring wraps.
+    // Stream::readBytes() and readString() wait for more.
+    //
+    while(count < size && !RX_BUFFER_EMPTY)
+    {
+        ulChunk = RX_BUFFER_USED;
+        if(ulChunk > rxBufferSize - (rxReadIndex & RX_BUFFER_MASK))
+        {
+            ulChunk = rxBufferSize - (rxReadIndex & RX_BUFFER_MASK);
+        }
+        if(ulChunk > size - count)
+        {
+            ulChunk = size - count;
+        }
+        memcpy(buffer + count, rxBuffer + (rxReadIndex & RX_BUFFER_MASK),
+               ulChunk);
+        rxReadIndex += ulChunk;
+        count += ulChunk;
+    }
+    unstallReceive();
+    return count;
+}
+
 void HardwareSerial::flush()
 {
     while(!TX_BUFFER_EMPTY);
 }
 
-size_t HardwareSerial::write(uint8_t c)
+size_t HardwareSerial::readRegion(const uint8_t **data)
 {
+    unsigned long ulCount = ringReadSpan(rxReadIndex, rxWriteIndex, rxBufferSize);
 
-    unsigned int numTransmit = 0;
-    //
-    // Check for valid arguments.
-    //
-    ASSERT(c != 0);
-/*
-    //this is not necessary: https://github.com/energia/Energia/issues/225
-    //
-    // If the character to the UART is \n, then add a \r before it so that
-    // \n is translated to \n\r in the output.
-    //
+    *data = rxBuffer + (rxReadIndex & RX_BUFFER_MASK);
+    return ulCount;
+}
+
+void HardwareSerial::consume(size_t n)
+{
+    if(n > RX_BUFFER_USED)
+    {
+        n = RX_BUFFER_USED;
+    }
+    rxReadIndex += n;
+    unstallReceive();
+}
 
-	// If the output buffer is full, there's nothing for it other than to
-	// wait for the interrupt handler to empty it a bit
+size_t HardwareSerial::writeRegion(uint8_t **data)
+{
+    unsigned long ulCount = ringWriteSpan(txReadIndex, txWriteIndex, txBufferSize);
+
+    *data = txBuffer + (txWriteIndex & TX_BUFFER_MASK);
+    return ulCount;
+}
 
-    if(c == '\n')
+void HardwareSerial::commit(size_t n)
+{
+    if(n > txBufferSize - TX_BUFFER_USED)
     {
-        while (TX_BUFFER_FULL);
-        txBuffer[txWriteIndex] = '\r';
-		txWriteIndex = (txWriteIndex + 1) % txBufferSize;
-        numTransmit ++;
+        n = txBufferSize - TX_BUFFER_USED;
     }
-*/
-    //
-    // Send the character to the UART output.
-    //
-    while (TX_BUFFER_FULL);
-    txBuffer[txWriteIndex] = c;
-    txWriteIndex = (txWriteIndex + 1) % txBufferSize;
-    numTransmit ++;
+    txWriteIndex += n;
+    if(TX_BUFFER_USED > stats.txPeak)
+    {
+        stats.txPeak = TX_BUFFER_USED;
+    }
+
+    kickTransmit();
+}
 
+size_t HardwareSerial::write(uint8_t c)
+{
     //
-    // If we have anything in the buffer, make sure that the UART is set
-    // up to transmit it.
+    // If the output buffer is full, there's nothing for it other than to
+    // wait for the interrupt handler to empty it a bit.
     //
-    if(!TX_BUFFER_EMPTY)
+    waitTransmitSpace();
+    txBuffer[txWriteIndex & TX_BUFFER_MASK] = c;
+    txWriteIndex++;
+    if(TX_BUFFER_USED > stats.txPeak)
     {
-	    primeTransmit(UART_BASE);
-        ROM_UARTIntEnable(UART_BASE, UART_INT_TX);
+        stats.txPeak = TX_BUFFER_USED;
     }
 
-    //
-    // Return the number of characters written.
-    //
-    return(numTransmit);
+    kickTransmit();
+
+    return(1);
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size)
+{
+    PROFILE_DRIVER_SCOPE("serial.write");
+
+    size_t count = size;
+    unsigned long ulChunk;
+
+    while(size)
+    {
+        waitTransmitSpace();
+
+        //
+        // Copy the largest span that fits without wrapping and publish it
+        // with a single index update.
+        //
+        ulChunk = txBufferSize - TX_BUFFER_USED;
+        if(ulChunk > txBufferSize - (txWriteIndex & TX_BUFFER_MASK))
+        {
+            ulChunk = txBufferSize - (txWriteIndex & TX_BUFFER_MASK);
+        }
+        if(ulChunk > size)
+        {
+            ulChunk = size;
+        }
+        memcpy(txBuffer + (txWriteIndex & TX_BUFFER_MASK), buffer, ulChunk);
+        txWriteIndex += ulChunk;
+        buffer += ulChunk;
+        size -= ulChunk;
+        if(TX_BUFFER_USED > stats.txPeak)
+        {
+            stats.txPeak = TX_BUFFER_USED;
+        }
+
+        kickTransmit();
+    }
+
+    return(count);
 }
 
 void HardwareSerial::UARTIntHandler(void){
-    unsigned long ulInts;
+    PROFILE_DRIVER_SCOPE("serial.isr");
+
+    unsigned long ulInts, ulCount;
     long lChar;
     // Get and clear the current interrupt source(s)
     //
     ulInts = ROM_UARTIntStatus(UART_BASE, true);
     ROM_UARTIntClear(UART_BASE, ulInts);
 
-    // Are we being interrupted because the TX FIFO has space available?
-    //
-    if(ulInts & UART_INT_TX)
+    if(dmaMode)
     {
-        //
-        // Move as many bytes as we can into the transmit FIFO.
-        //
-        primeTransmit(UART_BASE);
+        if(ulInts & UART_INT_OE)
+        {
+            stats.overruns++;
+        }
+        if(ulInts & UART_INT_BE)
+        {
+            stats.breaks++;
+        }
+        if(ulInts & UART_INT_PE)
+        {
+            stats.parityErrors++;
+        }
+        if(ulInts & UART_INT_FE)
+        {
+            stats.framingErrors++;
+        }
 
         //
-        // If the output buffer is empty, turn off the transmit interrupt.
+        // uDMA completions are signalled on the UART interrupt.
         //
-        if(TX_BUFFER_EMPTY)
+        ROM_uDMAIntClear(ROM_uDMAIntStatus() &
+                         ((1 << DMA_RX_CHANNEL) | (1 << DMA_TX_CHANNEL)));
+
+        if(txDmaCount && !ROM_uDMAChannelIsEnabled(DMA_TX_CHANNEL))
         {
-            ROM_UARTIntDisable(UART_BASE, UART_INT_TX);
+            txReadIndex += txDmaCount;
+            txDmaCount = 0;
         }
+        primeTransmitDMA();
+
+        receiveDMA(ulInts & UART_INT_RT);
+        return;
+    }
+
+    //
+    // Either the TX FIFO has space available or write() pended the interrupt
+    // to start a transmission. Move as many bytes as we can into the FIFO.
+    //
+    primeTransmit(UART_BASE);
+
+    //
+    // The reader made room after the buffer filled up under flow control.
+    //
+    if(rxStalled && !RX_BUFFER_FULL)
+    {
+        rxStalled = false;
+        ROM_UARTIntEnable(UART_BASE, UART_INT_RX | UART_INT_RT);
+        ulInts |= UART_INT_RX;
     }
+
     if(ulInts & (UART_INT_RX | UART_INT_RT))
     {
-        while(ROM_UARTCharsAvail(UART_BASE))
+        //
+        // The receive timeout only fires while the FIFO holds data. When
+        // watching for an idle line, take one less than the trigger level
+        // (8) on a receive interrupt so that a character is always left for
+        // the timeout to find.
+        //
+        ulCount = (frameIdle && !(ulInts & UART_INT_RT)) ? 7 : 0xFFFFFFFF;
+
+        while(ulCount-- && !(HWREG(UART_BASE + UART_O_FR) & UART_FR_RXFE))
+        {
+            //
+            // Under flow control a full buffer leaves the data in the FIFO.
+            // RTS goes off once that fills up too, and reading resumes when
+            // the buffer is drained (see unstallReceive()).
+            //
+            if(flowControl && !frameCallback && RX_BUFFER_FULL)
             {
+                rxStalled = true;
+                ROM_UARTIntDisable(UART_BASE, UART_INT_RX | UART_INT_RT);
+                break;
+            }
 
             //
             // Read a character
             //
-            lChar = ROM_UARTCharGetNonBlocking(UART_BASE);
+            lChar = HWREG(UART_BASE + UART_O_DR);
+
+            //
+            // Receive errors are reported alongside the character.
+            //
+            if(lChar & (UART_DR_OE | UART_DR_BE | UART_DR_PE | UART_DR_FE))
+            {
+                if(lChar & UART_DR_OE)
+                {
+                    stats.overruns++;
+                }
+                if(lChar & UART_DR_BE)
+                {
+                    stats.breaks++;
+                }
+                if(lChar & UART_DR_PE)
+                {
+                    stats.parityErrors++;
+                }
+                if(lChar & UART_DR_FE)
+                {
+                    stats.framingErrors++;
+                }
+            }
+
+            if(frameCallback)
+            {
+                frameByte((unsigned char)(lChar & 0xFF));
+                continue;
+            }
+
             //
             // If there is space in the receive buffer, put the character
             // there, otherwise throw it away.
             //
-            uint8_t volatile full = RX_BUFFER_FULL;
-            if(full) break;
+            if(RX_BUFFER_FULL)
+            {
+                stats.dropped++;
+                continue;
+            }
 
-            rxBuffer[rxWriteIndex] =
+            rxBuffer[rxWriteIndex & RX_BUFFER_MASK] =
                 (unsigned char)(lChar & 0xFF);
-            rxWriteIndex = ((rxWriteIndex) + 1) % rxBufferSize;
+            rxWriteIndex++;
+        }
 
-            //
-            // If we wrote anything to the transmit buffer, make sure it actually
-            // gets transmitted.
-            //
+        if(RX_BUFFER_USED > stats.rxPeak)
+        {
+            stats.rxPeak = RX_BUFFER_USED;
+        }
+
+        if(frameIdle && (ulInts & UART_INT_RT))
+        {
+            frameEnd();
+        }
+
+        if(!RX_BUFFER_EMPTY)
+        {
+            g_ulSerialEvents |= 1 << uartModule;
         }
-        primeTransmit(UART_BASE);
-        ROM_UARTIntEnable(UART_BASE, UART_INT_TX);
     }
 }
 
@@ -556,18 +1397,6 @@ void serialEvent6() {}
 void serialEvent7() __attribute__((weak));
 void serialEvent7() {}
 
-void serialEventRun(void)
-{
-    if (Serial.available()) serialEvent();
-    if (Serial1.available()) serialEvent1();
-    if (Serial2.available()) serialEvent2();
-    if (Serial3.available()) serialEvent3();
-    if (Serial4.available()) serialEvent4();
-    if (Serial5.available()) serialEvent5();
-    if (Serial6.available()) serialEvent6();
-    if (Serial7.available()) serialEvent7();
-}
-
 HardwareSerial Serial;
 HardwareSerial Serial1(1);
 HardwareSerial Serial2(2);
@@ -576,3 +1405,59 @@ HardwareSerial Serial4(4);
 HardwareSerial Serial5(5);
 HardwareSerial Serial6(6);
 HardwareSerial Serial7(7);
+
+static HardwareSerial * const g_pSerialPorts[8] =
+{
+    &Serial, &Serial1, &Serial2, &Serial3,
+    &Serial4, &Serial5, &Serial6, &Serial7
+};
+
+static void (* const g_pfnSerialEvent[8])(void) =
+{
+    serialEvent, serialEvent1, serialEvent2, serialEvent3,
+    serialEvent4, serialEvent5, serialEvent6, serialEvent7
+};
+
+void serialEventRun(void)
+{
+    unsigned long ulEvents, ulPending = 0, ulInt, i;
+
+    //
+    // Only visit the ports the interrupt handler stored data for.
+    //
+    ulInt = ROM_IntMasterDisable();
+    ulEvents = g_ulSerialEvents;
+    g_ulSerialEvents = 0;
+    if(!ulInt)
+    {
+        ROM_IntMasterEnable();
+    }
+
+    for(i = 0; ulEvents; i++, ulEvents >>= 1)
+    {
+        if(!(ulEvents & 1) || !g_pSerialPorts[i]->available())
+        {
+            continue;
+        }
+        g_pfnSerialEvent[i]();
+
+        //
+        // Whatever serialEvent left unread gets it called again on the
+        // next pass, as with polling.
+        //
+        if(g_pSerialPorts[i]->available())
+        {
+            ulPending |= 1 << i;
+        }
+    }
+
+    if(ulPending)
+    {
+        ulInt = ROM_IntMasterDisable();
+        g_ulSerialEvents |= ulPending;
+        if(!ulInt)
+        {
+            ROM_IntMasterEnable();
+        }
+    }
+}
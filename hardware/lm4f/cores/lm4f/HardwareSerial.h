@@ -38,6 +38,24 @@
 
 #define SERIAL_BUFFER_SIZE     256
 
+// Size of each of the two uDMA receive ping-pong blocks
+#define SERIAL_DMA_BLOCK_SIZE  64
+
+// Receives a completed frame, called from the UART interrupt
+typedef void (*SerialFrameCallback)(const uint8_t *frame, size_t length);
+
+// Receive error and buffer statistics, see HardwareSerial::getStats()
+typedef struct
+{
+    unsigned long dropped;          // received bytes lost to a full buffer
+    unsigned long overruns;         // receive FIFO overruns
+    unsigned long framingErrors;
+    unsigned long parityErrors;
+    unsigned long breaks;
+    unsigned long rxPeak;           // highest receive buffer occupancy
+    unsigned long txPeak;           // highest transmit buffer occupancy
+} SerialStats;
+
 #define UART1_PORTB	0 
 #define UART1_PORTC	1
 
@@ -47,32 +65,74 @@ class HardwareSerial : public Stream
 	private:
         unsigned char *txBuffer;
         unsigned long txBufferSize;
-        unsigned long txWriteIndex;
-        unsigned long txReadIndex;
+        volatile unsigned long txWriteIndex;
+        volatile unsigned long txReadIndex;
         unsigned char *rxBuffer;
         unsigned long rxBufferSize;
-        unsigned long rxWriteIndex;
-        unsigned long rxReadIndex;
+        volatile unsigned long rxWriteIndex;
+        volatile unsigned long rxReadIndex;
         unsigned long uartModule;
         unsigned long baudRate;
+        bool dmaMode;
+        unsigned char *rxDmaBuffer[2];
+        unsigned long rxDmaOffset;
+        unsigned long rxDmaActive;
+        volatile unsigned long txDmaCount;
+        SerialFrameCallback frameCallback;
+        unsigned char *frameBuffer;
+        unsigned long frameLength;
+        unsigned long frameCount;
+        int frameTerminator;
+        bool frameIdle;
+        bool flowControl;
+        volatile bool rxStalled;
+        SerialStats stats;
         void flushAll(void);
         void primeTransmit(unsigned long ulBase);
+        void primeTransmitDMA(void);
+        void kickTransmit(void);
+        void waitTransmitSpace(void);
+        void startDMA(void);
+        void stopDMA(void);
+        void receiveDMA(bool idle);
+        void rxBufferPut(const unsigned char *buf, unsigned long len);
+        void frameByte(unsigned char c);
+        void frameEnd(void);
+        void startFlowControl(void);
+        void unstallReceive(void);
 
     public:
 		HardwareSerial(void);
 		HardwareSerial(unsigned long);
 		void begin(unsigned long);
 		void setBufferSize(unsigned long, unsigned long);
+		void setDMA(bool);
 		void setModule(unsigned long);
 		void setPins(unsigned long);
+		void attachFrameCallback(SerialFrameCallback callback, size_t length,
+		                         int terminator = -1, bool idle = false);
+		void detachFrameCallback(void);
+		bool setFlowControl(bool);
+		void getStats(SerialStats *);
+		void clearStats(void);
 		void end(void);
 		virtual int available(void);
 		virtual int peek(void);
 		virtual int read(void);
+		virtual int read(uint8_t *buffer, size_t size);
 		virtual void flush(void);
         void UARTIntHandler(void);
         virtual size_t write(uint8_t c);
-		using Print::write; // pull in write(str) and write(buf, size) from Print
+        virtual size_t write(const uint8_t *buffer, size_t size);
+		using Print::write; // pull in write(str) from Print
+        // Zero-copy access to the ring buffers. readRegion() returns the
+        // contiguous run of received bytes, consume() releases them.
+        // writeRegion() returns the contiguous free space of the transmit
+        // buffer, commit() queues what was written there.
+        size_t readRegion(const uint8_t **data);
+        void consume(size_t n);
+        size_t writeRegion(uint8_t **data);
+        void commit(size_t n);
         
 };
 
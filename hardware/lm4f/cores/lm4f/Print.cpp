@@ -23,30 +23,98 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <math.h>
 #include "Energia.h"
 #include "Print.h"
+#include "numtostr.h"
+
+// Print Buffer ////////////////////////////////////////////////////////////////
+
+/*
+ * Collects the output of a single print()/println() call on the stack so
+ * that it reaches the underlying write() in one piece, e.g. as one TCP
+ * segment instead of one per character. Output that does not fit is passed
+ * on early, in PRINT_BUFFER_SIZE pieces.
+ */
+class PrintBuffer : public Print
+{
+  public:
+    PrintBuffer(Print &out) : out(out), len(0), count(0) {}
+
+    virtual size_t write(uint8_t c)
+    {
+        if (len == sizeof(buf)) flush();
+        buf[len++] = c;
+        return 1;
+    }
+
+    virtual size_t write(const uint8_t *buffer, size_t size)
+    {
+        if (len + size > sizeof(buf)) {
+            flush();
+            if (size > sizeof(buf)) {
+                count += out.write(buffer, size);
+                return size;
+            }
+        }
+        memcpy(buf + len, buffer, size);
+        len += size;
+        return size;
+    }
+
+    using Print::write;
+
+    /* One printf() conversion formatted in place, flushing first if it
+     * does not fit behind what is held. Cut off if it does not fit at all. */
+    template <typename T> void format(const char *spec, T value)
+    {
+        int n = snprintf((char *)buf + len, sizeof(buf) - len, spec, value);
+
+        if (n >= 0 && (size_t)n >= sizeof(buf) - len && len) {
+            flush();
+            n = snprintf((char *)buf, sizeof(buf), spec, value);
+        }
+        if (n < 0)
+            return;
+        len += (size_t)n < sizeof(buf) - len ? n : sizeof(buf) - len - 1;
+    }
+
+    /* Pass on what is left, returns the total written to the output */
+    size_t flush()
+    {
+        if (len) {
+            count += out.write(buf, len);
+            len = 0;
+        }
+        return count;
+    }
+
+  private:
+    Print &out;
+    uint8_t buf[PRINT_BUFFER_SIZE];
+    size_t len;
+    size_t count;
+};
 
 // Public Methods //////////////////////////////////////////////////////////////
 
 /* default implementation: may be overridden */
 size_t Print::write(const uint8_t *buffer, size_t size)
 {
-  size_t n = 0;
-  while (size--) {
-    n += write(*buffer++);
-  }
-  return n;
+    size_t n = 0;
+    while (size--) {
+        n += write(*buffer++);
+    }
+    return n;
 }
 
 
 size_t Print::print(const String &s)
 {
-    size_t n = 0;
-    for (uint16_t i = 0; i < s.length(); i++) {
-        n += write(s[i]);
-    }
-    return n;
+    return write((const uint8_t *)s.c_str(), s.length());
 }
 
 size_t Print::print(const char str[])
@@ -76,34 +144,34 @@ size_t Print::print(unsigned int n, int base)
 
 size_t Print::print(long n, int base)
 {
-    if (base == 0) {
-        return write(n);
-    } else if (base == 10) {
-        if (n < 0) {
-            int t = print('-');
-            n = -n;
-            return printNumber(n, 10) + t;
-        }
-        return printNumber(n, 10);
-    } else {
-        return printNumber(n, base);
-    }
+    if (base == 0) return write(n);
+
+    PrintBuffer buffer(*this);
+    buffer.printSigned(n, base);
+    return buffer.flush();
 }
 
 size_t Print::print(unsigned long n, int base)
 {
     if (base == 0) return write(n);
-    else return printNumber(n, base);
+
+    PrintBuffer buffer(*this);
+    buffer.printNumber(n, base);
+    return buffer.flush();
 }
 
 size_t Print::print(double n, int digits)
 {
-    return printFloat(n, digits);
+    PrintBuffer buffer(*this);
+    buffer.printFloat(n, digits);
+    return buffer.flush();
 }
 
 size_t Print::print(float n, int digits)
 {
-    return printFloat(n, digits);
+    PrintBuffer buffer(*this);
+    buffer.printFloat(n, digits);
+    return buffer.flush();
 }
 
 //size_t Print::println(const __FlashStringHelper *ifsh)
@@ -115,190 +183,255 @@ size_t Print::print(float n, int digits)
 
 size_t Print::print(const Printable& x)
 {
-    return x.printTo(*this);
+    PrintBuffer buffer(*this);
+    x.printTo(buffer);
+    return buffer.flush();
+}
+
+/*
+ * Streams through a PrintBuffer instead of formatting the whole output
+ * first: the text of the format is copied as it is and each conversion is
+ * formatted on its own, so the heap is never used. %s is written straight
+ * from the string; other conversions are cut off at PRINT_BUFFER_SIZE - 1
+ * characters. %n stores nothing.
+ */
+size_t Print::printf(const char *format, ...)
+{
+    PrintBuffer buffer(*this);
+    char spec[40], *p, size, conv;
+    const char *start;
+    int width, precision;
+    bool left;
+    va_list args;
+
+    va_start(args, format);
+    while (*format) {
+        if (*format != '%') {
+            start = format;
+            while (*format && *format != '%') format++;
+            buffer.write((const uint8_t *)start, format - start);
+            continue;
+        }
+        if (format[1] == '%') {
+            buffer.write('%');
+            format += 2;
+            continue;
+        }
+
+        // Rebuild the conversion for snprintf() with any * filled in
+        start = format++;
+        p = spec;
+        *p++ = '%';
+        left = false;
+        while (*format && strchr("-+ #0", *format)) {
+            if (*format == '-') left = true;
+            if (p < spec + 6) *p++ = *format;
+            format++;
+        }
+        width = 0;
+        if (*format == '*') {
+            width = va_arg(args, int);
+            format++;
+            if (width < 0) {
+                if (!left) *p++ = '-';
+                left = true;
+                width = -width;
+            }
+        } else {
+            while (*format >= '0' && *format <= '9')
+                width = width * 10 + *format++ - '0';
+        }
+        if (width) p += ultostr(width, p, 10, 0);
+        precision = -1;
+        if (*format == '.') {
+            format++;
+            if (*format == '*') {
+                precision = va_arg(args, int);
+                format++;
+            } else {
+                precision = 0;
+                while (*format >= '0' && *format <= '9')
+                    precision = precision * 10 + *format++ - '0';
+            }
+            if (precision >= 0) {
+                *p++ = '.';
+                p += ultostr(precision, p, 10, 0);
+            }
+        }
+        size = 0;                           // 'q' for ll
+        while (*format && strchr("hlLjzt", *format)) {
+            size = size == 'l' && *format == 'l' ? 'q' : *format;
+            if (p < spec + sizeof(spec) - 2) *p++ = *format;
+            format++;
+        }
+        conv = *format;
+        if (!conv) break;
+        format++;
+        *p++ = conv;
+        *p = 0;
+
+        switch (conv) {
+        case 'd': case 'i':
+            if (size == 'q') buffer.format(spec, va_arg(args, long long));
+            else if (size == 'l') buffer.format(spec, va_arg(args, long));
+            else if (size == 'j') buffer.format(spec, va_arg(args, intmax_t));
+            else if (size == 'z') buffer.format(spec, va_arg(args, size_t));
+            else if (size == 't') buffer.format(spec, va_arg(args, ptrdiff_t));
+            else buffer.format(spec, va_arg(args, int));
+            break;
+        case 'u': case 'o': case 'x': case 'X':
+            if (size == 'q') buffer.format(spec, va_arg(args, unsigned long long));
+            else if (size == 'l') buffer.format(spec, va_arg(args, unsigned long));
+            else if (size == 'j') buffer.format(spec, va_arg(args, uintmax_t));
+            else if (size == 'z') buffer.format(spec, va_arg(args, size_t));
+            else if (size == 't') buffer.format(spec, va_arg(args, ptrdiff_t));
+            else buffer.format(spec, va_arg(args, unsigned int));
+            break;
+        case 'c':
+            buffer.format(spec, va_arg(args, int));
+            break;
+        case 'e': case 'E': case 'f': case 'F':
+        case 'g': case 'G': case 'a': case 'A':
+            if (size == 'L') buffer.format(spec, va_arg(args, long double));
+            else buffer.format(spec, va_arg(args, double));
+            break;
+        case 'p':
+            buffer.format(spec, va_arg(args, void *));
+            break;
+        case 'n':
+            va_arg(args, void *);
+            break;
+        case 's': {
+            const char *str = va_arg(args, const char *);
+            int n = 0;
+
+            if (str == NULL) str = "(null)";
+            while ((precision < 0 || n < precision) && str[n]) n++;
+            if (!left) for (; width > n; width--) buffer.write(' ');
+            buffer.write((const uint8_t *)str, n);
+            for (; width > n; width--) buffer.write(' ');
+            break;
+        }
+        default:                            // not a conversion, print it as is
+            buffer.write((const uint8_t *)start, format - start);
+            break;
+        }
+    }
+    va_end(args);
+    return buffer.flush();
 }
 
 size_t Print::println(void)
 {
-    size_t n = print('\r');
-    n += print('\n');
-    return n;
+    return write("\r\n");
 }
 
 size_t Print::println(const String &s)
 {
-    size_t n = print(s);
-    n += println();
-    return n;
+    PrintBuffer buffer(*this);
+    buffer.write((const uint8_t *)s.c_str(), s.length());
+    buffer.println();
+    return buffer.flush();
 }
 
 size_t Print::println(const char c[])
 {
-    size_t n = print(c);
-    n += println();
-    return n;
+    PrintBuffer buffer(*this);
+    buffer.write(c);
+    buffer.println();
+    return buffer.flush();
 }
 
 size_t Print::println(char c)
 {
-    size_t n = print(c);
-    n += println();
-    return n;
+    const uint8_t buf[3] = { (uint8_t)c, '\r', '\n' };
+    return write(buf, sizeof(buf));
 }
 
 size_t Print::println(unsigned char b, int base)
 {
-    size_t n = print(b, base);
-    n += println();
-    return n;
+    return println((unsigned long) b, base);
 }
 
 size_t Print::println(int num, int base)
 {
-    size_t n = print(num, base);
-    n += println();
-    return n;
+    return println((long) num, base);
 }
 
 size_t Print::println(unsigned int num, int base)
 {
-    size_t n = print(num, base);
-    n += println();
-    return n;
+    return println((unsigned long) num, base);
 }
 
 size_t Print::println(long num, int base)
 {
-    size_t n = print(num, base);
-    n += println();
-    return n;
+    PrintBuffer buffer(*this);
+    if (base == 0) buffer.write(num);
+    else buffer.printSigned(num, base);
+    buffer.println();
+    return buffer.flush();
 }
 
 size_t Print::println(unsigned long num, int base)
 {
-    size_t n = print(num, base);
-    n += println();
-    return n;
+    PrintBuffer buffer(*this);
+    if (base == 0) buffer.write(num);
+    else buffer.printNumber(num, base);
+    buffer.println();
+    return buffer.flush();
 }
 
 size_t Print::println(double num, int digits)
 {
-    size_t n = print(num, digits);
-    n += println();
-    return n;
+    PrintBuffer buffer(*this);
+    buffer.printFloat(num, digits);
+    buffer.println();
+    return buffer.flush();
 }
 
 size_t Print::println(float num, int digits)
 {
-    size_t n = print(num, digits);
-    n += println();
-    return n;
+    PrintBuffer buffer(*this);
+    buffer.printFloat(num, digits);
+    buffer.println();
+    return buffer.flush();
 }
 
 size_t Print::println(const Printable& x)
 {
-    size_t n = print(x);
-    n += println();
-    return n;
+    PrintBuffer buffer(*this);
+    x.printTo(buffer);
+    buffer.println();
+    return buffer.flush();
 }
 
 // Private Methods /////////////////////////////////////////////////////////////
 
-size_t Print::printNumber(unsigned long n, uint8_t base) {
-    char buf[8 * sizeof(long) + 1]; // Assumes 8-bit chars plus zero byte.
-    char *str = &buf[sizeof(buf) - 1];
-
-    *str = '\0';
-
-    // prevent crash if called with base == 1
-    if (base < 2) base = 10;
-
-    do {
-        unsigned long m = n;
-        n /= base;
-        char c = m - base * n;
-        *--str = c < 10 ? c + '0' : c + 'A' - 10;
-    } while(n);
+/*
+ * The helpers below write straight to *this. The public methods run them
+ * on a PrintBuffer.
+ */
 
-    return write(str);
+size_t Print::printSigned(long n, int base)
+{
+    char buf[NUMTOSTR_LONG_LEN];
+    return write((const uint8_t *)buf, ltostr(n, buf, base, 1));
 }
 
-size_t Print::printFloat(double number, uint8_t digits) 
-{ 
-    size_t n = 0;
-
-    // Handle negative numbers
-    if (number < 0.0)
-    {
-        n += print('-');
-        number = -number;
-    }
-
-    // Round correctly so that print(1.999, 2) prints as "2.00"
-    double rounding = 0.5;
-    for (uint8_t i=0; i<digits; ++i)
-        rounding /= 10.0;
-
-    number += rounding;
-
-    // Extract the integer part of the number and print it
-    unsigned long int_part = (unsigned long)number;
-    double remainder = number - (double)int_part;
-    n += print(int_part);
-
-    // Print the decimal point, but only if there are digits beyond
-    if (digits > 0) {
-        n += print(".");
-    }
-
-    // Extract digits from the remainder one at a time
-    while (digits-- > 0)
-    {
-        remainder *= 10.0;
-        int toPrint = int(remainder);
-        n += print(toPrint);
-        remainder -= toPrint;
-    }
+size_t Print::printNumber(unsigned long n, uint8_t base)
+{
+    char buf[NUMTOSTR_LONG_LEN];
+    return write((const uint8_t *)buf, ultostr(n, buf, base, 1));
+}
 
-    return n;
+size_t Print::printFloat(double number, uint8_t digits)
+{
+    char buf[NUMTOSTR_FLOAT_LEN];
+    return write((const uint8_t *)buf, dtostr(number, buf, digits));
 }
 
 size_t Print::printFloat(float number, uint8_t digits)
 {
-    size_t n = 0;
-
-    // Handle negative numbers
-    if (number < 0.0)
-    {
-        n += print('-');
-        number = -number;
-    }
-
-    // Round correctly so that print(1.999, 2) prints as "2.00"
-    float rounding = 0.5;
-    for (uint8_t i=0; i<digits; ++i)
-        rounding /= 10.0;
-
-    number += rounding;
-
-    // Extract the integer part of the number and print it
-    unsigned long int_part = (unsigned long)number;
-    float remainder = number - (float)int_part;
-    n += print(int_part);
-
-    // Print the decimal point, but only if there are digits beyond
-    if (digits > 0) {
-        n += print(".");
-    }
-
-    // Extract digits from the remainder one at a time
-    while (digits-- > 0)
-    {
-        remainder *= 10.0;
-        int toPrint = int(remainder);
-        n += print(toPrint);
-        remainder -= toPrint;
-    }
-
-    return n;
+    char buf[NUMTOSTR_FLOAT_LEN];
+    return write((const uint8_t *)buf, ftostr(number, buf, digits));
 }
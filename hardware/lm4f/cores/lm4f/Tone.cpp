@@ -129,9 +129,12 @@ void noTone(uint8_t _pin)
     if(timer == tone_timer) {
 		uint32_t timerBase = getTimerBase(timerToOffset(timer));
 		uint32_t timerAB = TIMER_A << timerToAB(timer);
-		ROM_TimerIntDisable(timerBase, TIMER_TIMA_TIMEOUT << timerToAB(tone_timer));
-		ROM_TimerIntClear(timerBase, TIMER_TIMA_TIMEOUT << timerToAB(tone_timer));
-		ROM_TimerDisable(timerBase, timerAB);
+		// PWMWrite() leaves the millis()/micros() timebase alone, so here too
+		if (timerBase != TIMER5_BASE) {
+			ROM_TimerIntDisable(timerBase, TIMER_TIMA_TIMEOUT << timerToAB(tone_timer));
+			ROM_TimerIntClear(timerBase, TIMER_TIMA_TIMEOUT << timerToAB(tone_timer));
+			ROM_TimerDisable(timerBase, timerAB);
+		}
 		tone_state = 0;
 		g_duration = 0;
 		pinMode(_pin, OUTPUT);
@@ -38,6 +38,7 @@
 #include "inc/hw_types.h"
 #include "inc/hw_nvic.h"
 #include "inc/hw_ints.h"
+#include "inc/hw_gpio.h"
 #include "driverlib/gpio.h"
 #include "wiring_private.h"
 #include "driverlib/rom.h"
@@ -63,112 +64,152 @@ static void (*cbFuncsS[8])(void);
 static void (*cbFuncsT[8])(void);
 #endif
 
-void GPIOXIntHandler(uint32_t base, void (**funcs)(void))
-{
-	uint32_t i;
-	uint32_t isr = GPIOIntStatus(base, true);
+/*
+ * Capture mode: pins attached with attachCapture() have their Energia pin
+ * number here, by port number and bit, 0 (NOT_A_PIN) for the others.
+ * Their edges go into a ring instead of to a callback. The GPIO interrupts
+ * all run at the same priority, so the port handlers never preempt each
+ * other and are together the only writer.
+ */
+#if (CAPTURE_BUFFER_SIZE & (CAPTURE_BUFFER_SIZE - 1))
+#error "CAPTURE_BUFFER_SIZE must be a power of two"
+#endif
+#define CAPTURE_BUFFER_MASK (CAPTURE_BUFFER_SIZE - 1)
 
-	GPIOIntClear(base, isr);
+static uint8_t capturePins[PT + 1][8];
+static EdgeEvent captureBuffer[CAPTURE_BUFFER_SIZE];
+static volatile uint32_t captureWriteIndex;
+static volatile uint32_t captureReadIndex;
+static volatile uint32_t captureLost;
 
-	for (i=0; i<8; i++, isr>>=1) {
-		if ((isr & 0x1) == 0)
-			continue;
-		if (funcs[i])
+void GPIOXIntHandler(uint32_t base, uint8_t port, void (**funcs)(void))
+{
+	uint32_t i, index;
+	uint32_t cycles = profileCycles();
+	uint32_t isr = HWREG(base + GPIO_O_MIS);
+	uint32_t data = HWREG(base + (GPIO_O_DATA + (0xFF << 2)));
+
+	HWREG(base + GPIO_O_ICR) = isr;
+	isr &= 0xFF;    // the DMA done bit above the pins on TM4C129
+
+	// Highest set bit first, one pass per pin that fired
+	while (isr) {
+		i = 31 - __builtin_clz(isr);
+		isr &= ~(1 << i);
+
+		if (capturePins[port][i]) {
+			index = captureWriteIndex;
+			if (index - captureReadIndex == CAPTURE_BUFFER_SIZE) {
+				captureLost++;
+				continue;
+			}
+			captureBuffer[index & CAPTURE_BUFFER_MASK].cycles = cycles;
+			captureBuffer[index & CAPTURE_BUFFER_MASK].pin = capturePins[port][i];
+			captureBuffer[index & CAPTURE_BUFFER_MASK].edge =
+				(data & (1 << i)) ? RISING : FALLING;
+			captureWriteIndex = index + 1;
+		} else if (funcs[i]) {
 			funcs[i]();
+		}
 	}
 }
 
 void GPIOAIntHandler(void)
 {
-	GPIOXIntHandler(GPIO_PORTA_BASE, cbFuncsA);
+	GPIOXIntHandler(GPIO_PORTA_BASE, PA, cbFuncsA);
 }
 
 void GPIOBIntHandler(void)
 {
-	GPIOXIntHandler(GPIO_PORTB_BASE, cbFuncsB);
+	GPIOXIntHandler(GPIO_PORTB_BASE, PB, cbFuncsB);
 }
 
 void GPIOCIntHandler(void)
 {
-	GPIOXIntHandler(GPIO_PORTC_BASE, cbFuncsC);
+	GPIOXIntHandler(GPIO_PORTC_BASE, PC, cbFuncsC);
 }
 
 void GPIODIntHandler(void)
 {
-	GPIOXIntHandler(GPIO_PORTD_BASE, cbFuncsD);
+	GPIOXIntHandler(GPIO_PORTD_BASE, PD, cbFuncsD);
 }
 
 void GPIOEIntHandler(void)
 {
-	GPIOXIntHandler(GPIO_PORTE_BASE, cbFuncsE);
+	GPIOXIntHandler(GPIO_PORTE_BASE, PE, cbFuncsE);
 }
 
 void GPIOFIntHandler(void)
 {
-	GPIOXIntHandler(GPIO_PORTF_BASE, cbFuncsF);
+	GPIOXIntHandler(GPIO_PORTF_BASE, PF, cbFuncsF);
 }
 
 void GPIOGIntHandler(void)
 {
-	GPIOXIntHandler(GPIO_PORTG_BASE, cbFuncsG);
+	GPIOXIntHandler(GPIO_PORTG_BASE, PG, cbFuncsG);
 }
 
 void GPIOHIntHandler(void)
 {
-	GPIOXIntHandler(GPIO_PORTH_BASE, cbFuncsH);
+	GPIOXIntHandler(GPIO_PORTH_BASE, PH, cbFuncsH);
 }
 
 void GPIOJIntHandler(void)
 {
-	GPIOXIntHandler(GPIO_PORTJ_BASE, cbFuncsJ);
+	GPIOXIntHandler(GPIO_PORTJ_BASE, PJ, cbFuncsJ);
 }
 
 void GPIOKIntHandler(void)
 {
-	GPIOXIntHandler(GPIO_PORTK_BASE, cbFuncsK);
+	GPIOXIntHandler(GPIO_PORTK_BASE, PK, cbFuncsK);
 }
 
 void GPIOLIntHandler(void)
 {
-	GPIOXIntHandler(GPIO_PORTL_BASE, cbFuncsL);
+	GPIOXIntHandler(GPIO_PORTL_BASE, PL, cbFuncsL);
 }
 
 void GPIOMIntHandler(void)
 {
-	GPIOXIntHandler(GPIO_PORTM_BASE, cbFuncsM);
+	GPIOXIntHandler(GPIO_PORTM_BASE, PM, cbFuncsM);
 }
 void GPIONIntHandler(void)
 {
-	GPIOXIntHandler(GPIO_PORTN_BASE, cbFuncsN);
+	GPIOXIntHandler(GPIO_PORTN_BASE, PN, cbFuncsN);
 }
 
 void GPIOPIntHandler(void)
 {
-	GPIOXIntHandler(GPIO_PORTP_BASE, cbFuncsP);
+	GPIOXIntHandler(GPIO_PORTP_BASE, PP, cbFuncsP);
 }
 
 void GPIOQIntHandler(void)
 {
-	GPIOXIntHandler(GPIO_PORTQ_BASE, cbFuncsQ);
+	GPIOXIntHandler(GPIO_PORTQ_BASE, PQ, cbFuncsQ);
 }
 
 #ifdef TARGET_IS_SNOWFLAKE_RA0
 void GPIORIntHandler(void)
 {
-	GPIOXIntHandler(GPIO_PORTR_BASE, cbFuncsR);
+	GPIOXIntHandler(GPIO_PORTR_BASE, PR, cbFuncsR);
 }
 
 void GPIOSIntHandler(void)
 {
-	GPIOXIntHandler(GPIO_PORTS_BASE, cbFuncsS);
+	GPIOXIntHandler(GPIO_PORTS_BASE, PS, cbFuncsS);
 }
 
 void GPIOTIntHandler(void)
 {
-	GPIOXIntHandler(GPIO_PORTT_BASE, cbFuncsT);
+	GPIOXIntHandler(GPIO_PORTT_BASE, PT, cbFuncsT);
 }
 #endif
 
+static uint32_t bitToIndex(uint8_t bit)
+{
+	return 31 - __builtin_clz(bit);
+}
+
 void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode)
 {
 	uint32_t lm4fMode, i;
@@ -177,6 +218,8 @@ void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode)
 	uint8_t port = digitalPinToPort(interruptNum);
 	uint32_t portBase = (uint32_t) portBASERegister(port);
 
+	if (port == NOT_A_PORT) return;
+
 	switch(mode) {
 	case LOW:
 		lm4fMode = GPIO_LOW_LEVEL;
@@ -195,6 +238,7 @@ void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode)
 	}
 
 	ROM_IntMasterDisable();
+	capturePins[port][bitToIndex(bit)] = NOT_A_PIN;
 	GPIOIntClear(portBase, bit);
 	ROM_GPIOIntTypeSet(portBase, bit, lm4fMode);
 	GPIOIntEnable(portBase, bit);
@@ -308,6 +352,7 @@ void detachInterrupt(uint8_t interruptNum)
 	if (port == NOT_A_PIN) return;
 
 	GPIOIntDisable(portBase, bit);
+	capturePins[port][bitToIndex(bit)] = NOT_A_PIN;
 
 	for (i=0; i<8; i++, bit>>=1) {
 		if ((bit & 0x1) == 1)
@@ -355,3 +400,37 @@ void detachInterrupt(uint8_t interruptNum)
 #endif
 	}
 }
+
+void attachCapture(uint8_t pin, int mode)
+{
+	uint8_t port = digitalPinToPort(pin);
+
+	if (port == NOT_A_PORT || mode == LOW)
+		return;
+
+	// Routes the port interrupt here, then marks the pin for the ring
+	attachInterrupt(pin, 0, mode);
+	capturePins[port][bitToIndex(digitalPinToBitMask(pin))] = pin;
+}
+
+int captureRead(EdgeEvent *events, int max)
+{
+	uint32_t index = captureReadIndex;
+	uint32_t end = captureWriteIndex;
+	int n = 0;
+
+	while (index != end && n < max)
+		events[n++] = captureBuffer[index++ & CAPTURE_BUFFER_MASK];
+	captureReadIndex = index;
+	return n;
+}
+
+int captureAvailable(void)
+{
+	return captureWriteIndex - captureReadIndex;
+}
+
+unsigned long captureOverflows(void)
+{
+	return captureLost;
+}
@@ -20,7 +20,7 @@
 */
 
 #include "WString.h"
-#include "itoa.h"
+#include "numtostr.h"
 
 
 /*********************************************/
@@ -64,46 +64,62 @@ String::String(char c)
 String::String(unsigned char value, unsigned char base)
 {
 	init();
-	char buf[9];
-	utoa(value, buf, base);
+	char buf[NUMTOSTR_LONG_LEN];
+	ultostr(value, buf, base, 0);
 	*this = buf;
 }
 
 String::String(int value, unsigned char base)
 {
 	init();
-	char buf[18];
-	itoa(value, buf, base);
+	char buf[NUMTOSTR_LONG_LEN];
+	ltostr(value, buf, base, 0);
 	*this = buf;
 }
 
 String::String(unsigned int value, unsigned char base)
 {
 	init();
-	char buf[17];
-	utoa(value, buf, base);
+	char buf[NUMTOSTR_LONG_LEN];
+	ultostr(value, buf, base, 0);
 	*this = buf;
 }
 
 String::String(long value, unsigned char base)
 {
 	init();
-	char buf[34];
-	ltoa(value, buf, base);
+	char buf[NUMTOSTR_LONG_LEN];
+	ltostr(value, buf, base, 0);
 	*this = buf;
 }
 
 String::String(unsigned long value, unsigned char base)
 {
 	init();
-	char buf[33];
-	ultoa(value, buf, base);
+	char buf[NUMTOSTR_LONG_LEN];
+	ultostr(value, buf, base, 0);
+	*this = buf;
+}
+
+String::String(float value, unsigned char decimalPlaces)
+{
+	init();
+	char buf[NUMTOSTR_FLOAT_LEN];
+	ftostr(value, buf, decimalPlaces);
+	*this = buf;
+}
+
+String::String(double value, unsigned char decimalPlaces)
+{
+	init();
+	char buf[NUMTOSTR_FLOAT_LEN];
+	dtostr(value, buf, decimalPlaces);
 	*this = buf;
 }
 
 String::~String()
 {
-	free(buffer);
+	if (!(flags & STRING_INLINE)) free(buffer);
 }
 
 /*********************************************/
@@ -120,9 +136,10 @@ inline void String::init(void)
 
 void String::invalidate(void)
 {
-	if (buffer) free(buffer);
+	if (buffer && !(flags & STRING_INLINE)) free(buffer);
 	buffer = NULL;
 	capacity = len = 0;
+	flags &= ~STRING_INLINE;
 }
 
 unsigned char String::reserve(unsigned int size)
@@ -135,15 +152,47 @@ unsigned char String::reserve(unsigned int size)
 	return 0;
 }
 
+// Make room for size characters when appending.  The capacity grows by
+// at least half each time, so a string built up piece by piece is moved
+// a logarithmic rather than linear number of times.  When the larger
+// block is not available the exact size is tried.
+unsigned char String::grow(unsigned int size)
+{
+	unsigned int more = capacity + (capacity >> 1);
+
+	if (buffer && capacity >= size) return 1;
+	if (buffer && size < more && reserve(more)) return 1;
+	return reserve(size);
+}
+
 unsigned char String::changeBuffer(unsigned int maxStrLen)
 {
-	char *newbuffer = (char *)realloc(buffer, maxStrLen + 1);
-	if (newbuffer) {
-		buffer = newbuffer;
-		capacity = maxStrLen;
-		return 1;
+	char *newbuffer;
+
+	if (buffer == NULL || (flags & STRING_INLINE)) {
+		if (maxStrLen < STRING_SSO_SIZE) {
+			newbuffer = sso;
+		} else {
+			newbuffer = (char *)malloc(maxStrLen + 1);
+			if (!newbuffer) return 0;
+		}
+		if (newbuffer != buffer) {
+			if (buffer) memcpy(newbuffer, buffer, len);
+			newbuffer[len] = 0;
+		}
+		if (newbuffer == sso) {
+			flags |= STRING_INLINE;
+			maxStrLen = STRING_SSO_SIZE - 1;
+		} else {
+			flags &= ~STRING_INLINE;
+		}
+	} else {
+		newbuffer = (char *)realloc(buffer, maxStrLen + 1);
+		if (!newbuffer) return 0;
 	}
-	return 0;
+	buffer = newbuffer;
+	capacity = maxStrLen;
+	return 1;
 }
 
 /*********************************************/
@@ -164,19 +213,23 @@ String & String::copy(const char *cstr, unsigned int _length)
 #ifdef __GXX_EXPERIMENTAL_CXX0X__
 void String::move(String &rhs)
 {
-	if (buffer) {
-		if (capacity >= rhs.len) {
-			strcpy(buffer, rhs.buffer);
-			len = rhs.len;
-			rhs.len = 0;
-			return;
-		} else {
-			free(buffer);
-		}
+	if (!rhs.buffer) {
+		invalidate();
+		return;
+	}
+	// an inline buffer cannot be handed over, nor is there a point when
+	// this string already has the room
+	if ((rhs.flags & STRING_INLINE) || (buffer && capacity >= rhs.len)) {
+		copy(rhs.buffer, rhs.len);
+		rhs.len = 0;
+		rhs.buffer[0] = 0;
+		return;
 	}
+	if (!(flags & STRING_INLINE)) free(buffer);
 	buffer = rhs.buffer;
 	capacity = rhs.capacity;
 	len = rhs.len;
+	flags &= ~STRING_INLINE;
 	rhs.buffer = NULL;
 	rhs.capacity = 0;
 	rhs.len = 0;
@@ -229,9 +282,10 @@ unsigned char String::concat(const char *cstr, unsigned int _length)
 	unsigned int newlen = len + _length;
 	if (!cstr) return 0;
 	if (_length == 0) return 1;
-	if (!reserve(newlen)) return 0;
-	strcpy(buffer + len, cstr);
+	if (!grow(newlen)) return 0;
+	memcpy(buffer + len, cstr, _length);
 	len = newlen;
+	buffer[len] = 0;
 	return 1;
 }
 
@@ -251,37 +305,32 @@ unsigned char String::concat(char c)
 
 unsigned char String::concat(unsigned char num)
 {
-	char buf[4];
-	itoa(num, buf, 10);
-	return concat(buf, strlen(buf));
+	char buf[NUMTOSTR_LONG_LEN];
+	return concat(buf, ultostr(num, buf, 10, 0));
 }
 
 unsigned char String::concat(int num)
 {
-	char buf[12];
-	itoa(num, buf, 10);
-	return concat(buf, strlen(buf));
+	char buf[NUMTOSTR_LONG_LEN];
+	return concat(buf, ltostr(num, buf, 10, 0));
 }
 
 unsigned char String::concat(unsigned int num)
 {
-	char buf[11];
-	utoa(num, buf, 10);
-	return concat(buf, strlen(buf));
+	char buf[NUMTOSTR_LONG_LEN];
+	return concat(buf, ultostr(num, buf, 10, 0));
 }
 
 unsigned char String::concat(long num)
 {
-	char buf[12];
-	ltoa(num, buf, 10);
-	return concat(buf, strlen(buf));
+	char buf[NUMTOSTR_LONG_LEN];
+	return concat(buf, ltostr(num, buf, 10, 0));
 }
 
 unsigned char String::concat(unsigned long num)
 {
-	char buf[11];
-	ultoa(num, buf, 10);
-	return concat(buf, strlen(buf));
+	char buf[NUMTOSTR_LONG_LEN];
+	return concat(buf, ultostr(num, buf, 10, 0));
 }
 
 /*********************************************/
@@ -464,6 +513,76 @@ void String::getBytes(unsigned char *buf, unsigned int bufsize, unsigned int ind
 	buf[n] = 0;
 }
 
+/*********************************************/
+/*  Substring search                         */
+/*********************************************/
+
+// Horspool search.  The skip table is indexed by the low SEARCH_BITS of a
+// character; characters sharing an index share the smallest skip, which
+// is still safe.  Short patterns and texts are scanned directly, there
+// the table costs more than it saves.
+#define SEARCH_BITS	8
+#define SEARCH_SIZE	(1 << SEARCH_BITS)
+#define SEARCH_MASK	(SEARCH_SIZE - 1)
+
+// first occurrence of p[0..plen) in s[0..slen)
+static const char *search(const char *s, unsigned int slen, const char *p, unsigned int plen)
+{
+	unsigned char skip[SEARCH_SIZE];
+	unsigned int i, pos, last;
+
+	if (plen == 0) return s;
+	if (plen > slen) return NULL;
+	if (plen < 3 || slen < SEARCH_SIZE) {
+		const char *end = s + slen - plen + 1;
+		while ((s = (const char *)memchr(s, p[0], end - s)) != NULL) {
+			if (memcmp(s + 1, p + 1, plen - 1) == 0) return s;
+			if (++s == end) break;
+		}
+		return NULL;
+	}
+
+	last = plen - 1;
+	memset(skip, plen < 255 ? plen : 255, sizeof(skip));
+	for (i = 0; i < last; i++)
+		skip[p[i] & SEARCH_MASK] = last - i < 255 ? last - i : 255;
+
+	for (pos = 0; pos <= slen - plen; pos += skip[s[pos + last] & SEARCH_MASK]) {
+		if (s[pos + last] == p[last] && memcmp(s + pos, p, last) == 0)
+			return s + pos;
+	}
+	return NULL;
+}
+
+// last occurrence of p[0..plen) in s[0..slen) starting at or before from
+static const char *searchBack(const char *s, unsigned int slen, const char *p, unsigned int plen, unsigned int from)
+{
+	unsigned char skip[SEARCH_SIZE];
+	unsigned int i, pos, step;
+
+	if (plen > slen) return NULL;
+	if (from > slen - plen) from = slen - plen;
+	if (plen < 3 || from < SEARCH_SIZE) {
+		for (pos = from + 1; pos-- > 0; ) {
+			if (s[pos] == p[0] && memcmp(s + pos + 1, p + 1, plen - 1) == 0)
+				return s + pos;
+		}
+		return NULL;
+	}
+
+	memset(skip, plen < 255 ? plen : 255, sizeof(skip));
+	for (i = plen - 1; i > 0; i--)
+		skip[p[i] & SEARCH_MASK] = i < 255 ? i : 255;
+
+	for (pos = from; ; pos -= step) {
+		if (s[pos] == p[0] && memcmp(s + pos + 1, p + 1, plen - 1) == 0)
+			return s + pos;
+		step = skip[s[pos] & SEARCH_MASK];
+		if (step > pos) break;
+	}
+	return NULL;
+}
+
 /*********************************************/
 /*  Search                                   */
 /*********************************************/
@@ -488,8 +607,8 @@ int String::indexOf(const String &s2) const
 
 int String::indexOf(const String &s2, unsigned int fromIndex) const
 {
-	if (fromIndex >= len) return -1;
-	const char *found = strstr(buffer + fromIndex, s2.buffer);
+	if (fromIndex >= len || !s2.buffer) return -1;
+	const char *found = search(buffer + fromIndex, len - fromIndex, s2.buffer, s2.len);
 	if (found == NULL) return -1;
 	return found - buffer;
 }
@@ -519,13 +638,9 @@ int String::lastIndexOf(const String &s2, unsigned int fromIndex) const
 {
   	if (s2.len == 0 || len == 0 || s2.len > len) return -1;
 	if (fromIndex >= len) fromIndex = len - 1;
-	int found = -1;
-	for (char *p = buffer; p <= buffer + fromIndex; p++) {
-		p = strstr(p, s2.buffer);
-		if (!p) break;
-		if ((unsigned int)(p - buffer) <= fromIndex) found = p - buffer;
-	}
-	return found;
+	const char *found = searchBack(buffer, len, s2.buffer, s2.len, fromIndex);
+	if (found == NULL) return -1;
+	return found - buffer;
 }
 
 String String::substring(unsigned int left, unsigned int right) const
@@ -561,43 +676,36 @@ void String::replace(const String& find, const String& _replace)
 {
 	if (len == 0 || find.len == 0) return;
 	int diff = _replace.len - find.len;
-	char *readFrom = buffer;
-	char *foundAt;
-	if (diff == 0) {
-		while ((foundAt = strstr(readFrom, find.buffer)) != NULL) {
-			memcpy(foundAt, _replace.buffer, _replace.len);
-			readFrom = foundAt + _replace.len;
-		}
-	} else if (diff < 0) {
-		char *writeTo = buffer;
-		while ((foundAt = strstr(readFrom, find.buffer)) != NULL) {
-			unsigned int n = foundAt - readFrom;
-			memcpy(writeTo, readFrom, n);
-			writeTo += n;
-			memcpy(writeTo, _replace.buffer, _replace.len);
-			writeTo += _replace.len;
-			readFrom = foundAt + find.len;
-			len += diff;
-		}
-		strcpy(writeTo, readFrom);
-	} else {
-		unsigned int size = len; // compute size needed for result
-		while ((foundAt = strstr(readFrom, find.buffer)) != NULL) {
+	unsigned int size = len;
+	const char *readFrom = buffer;
+	const char *end = buffer + len;
+	const char *foundAt;
+	if (diff > 0) {
+		// compute size needed for result
+		while ((foundAt = search(readFrom, end - readFrom, find.buffer, find.len)) != NULL) {
 			readFrom = foundAt + find.len;
 			size += diff;
 		}
 		if (size == len) return;
 		if (size > capacity && !changeBuffer(size)) return; // XXX: tell user!
-		int index = len - 1;
-		while (index >= 0 && (index = lastIndexOf(find, index)) >= 0) {
-			readFrom = buffer + index + find.len;
-			memmove(readFrom + diff, readFrom, len - (readFrom - buffer));
-			len += diff;
-			buffer[len] = 0;
-			memcpy(buffer + index, _replace.buffer, _replace.len);
-			index--;
-		}
+		// move the text to the end of the buffer, the result is built in
+		// front of it and never catches up with what is still to be read
+		memmove(buffer + size - len, buffer, len);
+		readFrom = buffer + size - len;
+		end = buffer + size;
+	}
+	char *writeTo = buffer;
+	while ((foundAt = search(readFrom, end - readFrom, find.buffer, find.len)) != NULL) {
+		unsigned int n = foundAt - readFrom;
+		if (writeTo != readFrom) memmove(writeTo, readFrom, n);
+		writeTo += n;
+		memcpy(writeTo, _replace.buffer, _replace.len);
+		writeTo += _replace.len;
+		readFrom = foundAt + find.len;
 	}
+	if (writeTo != readFrom) memmove(writeTo, readFrom, end - readFrom);
+	len = writeTo + (end - readFrom) - buffer;
+	buffer[len] = 0;
 }
 
 void String::toLowerCase(void)
@@ -14,6 +14,8 @@
 #include "driverlib/rom.h"
 #include "driverlib/sysctl.h"
 #include "driverlib/eeprom.h"
+#include "wheeltimer.h"
+#include "cotask.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -61,10 +63,13 @@ void _init(void)
 
 int main(void)
 {
+	profileInit();
 	setup();
 
 	for (;;) {
 		loop();
 		if (serialEventRun) serialEventRun();
+		wheelTimerRun();
+		coTaskRun();
 	}
 }
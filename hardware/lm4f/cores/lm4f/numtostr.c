@@ -0,0 +1,284 @@
+/*
+  numtostr.c - Integer and floating point to text conversion shared by
+  Print and String
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include "numtostr.h"
+
+static const char digitPairs[] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+static const char lowerDigits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+static const char upperDigits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+/* Copy the digits built backwards from end down to p into buf */
+static size_t finish( const char *p, const char *end, char *buf )
+{
+  size_t len = end - p;
+
+  memcpy(buf, p, len);
+  buf[len] = 0;
+  return len;
+}
+
+/*
+ * Base 10, two digits per step. On 32 bit cores the division by 100 is a
+ * multiplication by its reciprocal, exact for all 32 bit values. On 16 bit
+ * cores (msp430, c2000) that 64 bit product is itself a library call, so
+ * they keep the plain division.
+ */
+#ifndef NUMTOSTR_RECIPROCAL
+#if UINT_MAX > 0xFFFFU
+#define NUMTOSTR_RECIPROCAL 1
+#else
+#define NUMTOSTR_RECIPROCAL 0
+#endif
+#endif
+
+static char *ultostr10( unsigned long value, char *p )
+{
+  uint32_t v, q;
+  unsigned int r;
+
+#if ULONG_MAX > 0xFFFFFFFFUL
+  while (value > 0xFFFFFFFFUL) {
+    r = (unsigned int)(value % 100);
+    value /= 100;
+    p -= 2;
+    p[0] = digitPairs[2 * r];
+    p[1] = digitPairs[2 * r + 1];
+  }
+#endif
+  v = (uint32_t)value;
+
+  while (v >= 100) {
+#if NUMTOSTR_RECIPROCAL
+    q = (uint32_t)(((uint64_t)v * 0x51EB851FUL) >> 37);
+#else
+    q = v / 100;
+#endif
+    r = (unsigned int)(v - q * 100);
+    v = q;
+    p -= 2;
+    p[0] = digitPairs[2 * r];
+    p[1] = digitPairs[2 * r + 1];
+  }
+
+  if (v >= 10) {
+    p -= 2;
+    p[0] = digitPairs[2 * v];
+    p[1] = digitPairs[2 * v + 1];
+  } else {
+    *--p = '0' + v;
+  }
+  return p;
+}
+
+extern size_t ultostr( unsigned long value, char *buf, int base, int upper )
+{
+  char tmp[NUMTOSTR_LONG_LEN];
+  char *end = tmp + sizeof(tmp);
+  char *p = end;
+  const char *digits = upper ? upperDigits : lowerDigits;
+  unsigned int shift;
+
+  if (base < 2 || base > 36)
+    base = 10;
+
+  if (base == 10) {
+    p = ultostr10(value, p);
+  } else if ((base & (base - 1)) == 0) {
+    /* Powers of two: mask and shift */
+    for (shift = 1; (1 << shift) != base; shift++)
+      ;
+    do {
+      *--p = digits[value & (base - 1)];
+      value >>= shift;
+    } while (value);
+  } else {
+    do {
+      *--p = digits[value % base];
+      value /= base;
+    } while (value);
+  }
+
+  return finish(p, end, buf);
+}
+
+extern size_t ltostr( long value, char *buf, int base, int upper )
+{
+  if (value < 0 && (base == 10 || base < 2 || base > 36)) {
+    *buf = '-';
+    return 1 + ultostr(-(unsigned long)value, buf + 1, 10, upper);
+  }
+  return ultostr(value, buf, base, upper);
+}
+
+/*
+ * Print (-1)^neg * mant * 2^exp2 with digits fraction digits.
+ *
+ * The integer part is taken from the mantissa by shifting. The fraction is
+ * held as a 128 bit binary fixed point number in four 32 bit words, which
+ * is exact for every value above 2^-75; anything smaller cannot reach half
+ * of the 16th fraction digit and only sets a sticky flag. It is turned
+ * into decimal one digit at a time by multiplying with 10, the carry out of
+ * the top being the next digit. What is left after the last digit decides
+ * the rounding. Only integer arithmetic is used, no floating point library
+ * is pulled in.
+ */
+static size_t fixtostr( int neg, uint64_t mant, int exp2, char *buf,
+                        unsigned char digits )
+{
+  uint32_t frac[4] = { 0, 0, 0, 0 };   /* most significant first */
+  uint64_t hi = 0, lo = 0, t;
+  uint32_t ip, carry;
+  int sticky = 0, up;
+  unsigned int k, i, j;
+  char fd[NUMTOSTR_FLOAT_DIGITS];
+  char tmp[11];
+  char *p = buf, *q;
+
+  if (digits > NUMTOSTR_FLOAT_DIGITS)
+    digits = NUMTOSTR_FLOAT_DIGITS;
+
+  if (exp2 >= 0) {
+    if (exp2 > 31 || (mant >> (32 - exp2)) != 0)
+      goto ovf;
+    ip = (uint32_t)(mant << exp2);
+  } else {
+    /* The fraction is (mant mod 2^k) << (128 - k) */
+    k = -exp2;
+    if (k < 64) {
+      if ((mant >> k) > 0xFFFFFFFFUL)
+        goto ovf;
+      ip = (uint32_t)(mant >> k);
+      hi = (mant & ((((uint64_t)1) << k) - 1)) << (64 - k);
+    } else {
+      ip = 0;
+      if (k > 128)
+        sticky = (mant != 0);
+      else if (k == 128)
+        lo = mant;
+      else if (k > 64) {
+        hi = mant >> (k - 64);
+        lo = mant << (128 - k);
+      } else
+        hi = mant;
+    }
+    frac[0] = (uint32_t)(hi >> 32);
+    frac[1] = (uint32_t)hi;
+    frac[2] = (uint32_t)(lo >> 32);
+    frac[3] = (uint32_t)lo;
+  }
+
+  /* frac * 10 word by word, the carry out of the top is the next digit */
+  for (i = 0; i < digits; i++) {
+    carry = 0;
+    for (j = 4; j-- > 0; ) {
+      t = (uint64_t)frac[j] * 10 + carry;
+      frac[j] = (uint32_t)t;
+      carry = (uint32_t)(t >> 32);
+    }
+    fd[i] = (char)carry;
+  }
+
+  /* Round what is left: above half up, exactly half to even */
+  if (frac[0] != 0x80000000UL || frac[1] || frac[2] || frac[3])
+    up = (frac[0] >= 0x80000000UL);
+  else
+    up = sticky || ((digits ? (uint32_t)fd[digits - 1] : ip) & 1);
+
+  if (up) {
+    for (i = digits; i > 0 && fd[i - 1] == 9; i--)
+      fd[i - 1] = 0;
+    if (i > 0) {
+      fd[i - 1]++;
+    } else {
+      if (ip == 0xFFFFFFFFUL)
+        goto ovf;
+      ip++;
+    }
+  }
+
+  if (neg && mant)
+    *p++ = '-';
+
+  q = ultostr10(ip, tmp + sizeof(tmp));
+  memcpy(p, q, tmp + sizeof(tmp) - q);
+  p += tmp + sizeof(tmp) - q;
+
+  if (digits) {
+    *p++ = '.';
+    for (i = 0; i < digits; i++)
+      *p++ = '0' + fd[i];
+  }
+  *p = 0;
+  return p - buf;
+
+ovf:
+  strcpy(buf, "ovf");
+  return 3;
+}
+
+extern size_t dtostr( double value, char *buf, unsigned char digits )
+{
+  union { double d; uint64_t u; } v;
+  unsigned int e;
+
+  /* Some of the parts have a 32 bit double */
+  if (sizeof(double) == sizeof(float))
+    return ftostr((float)value, buf, digits);
+
+  v.d = value;
+  e = (unsigned int)(v.u >> 52) & 0x7FF;
+  if (e == 0x7FF) {
+    strcpy(buf, (v.u << 12) ? "nan" : "inf");
+    return 3;
+  }
+  if (e == 0)
+    return fixtostr(v.u >> 63, v.u & 0xFFFFFFFFFFFFFULL, -1074, buf, digits);
+  return fixtostr(v.u >> 63, (v.u & 0xFFFFFFFFFFFFFULL) | (1ULL << 52),
+                  (int)e - 1075, buf, digits);
+}
+
+extern size_t ftostr( float value, char *buf, unsigned char digits )
+{
+  union { float f; uint32_t u; } v;
+  unsigned int e;
+
+  v.f = value;
+  e = (unsigned int)(v.u >> 23) & 0xFF;
+  if (e == 0xFF) {
+    strcpy(buf, (v.u << 9) ? "nan" : "inf");
+    return 3;
+  }
+  if (e == 0)
+    return fixtostr(v.u >> 31, v.u & 0x7FFFFF, -149, buf, digits);
+  return fixtostr(v.u >> 31, (v.u & 0x7FFFFF) | 0x800000UL,
+                  (int)e - 150, buf, digits);
+}
@@ -0,0 +1,67 @@
+/*
+  pingroup.h - Reading and writing several pins of one port in a single
+  register access
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _PINGROUP_
+#define _PINGROUP_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif // __cplusplus
+
+#define PINGROUP_MAX    8
+
+/*
+ * Up to eight pins on one port, e.g. the data lines of a display. Bit i of
+ * a value goes to the i-th pin given to pinGroupInit(). The fields are
+ * private.
+ */
+typedef struct PinGroup {
+	uint8_t port;                 // NOT_A_PORT if the pins are not on one
+	uint8_t mask;                 // port bits of all the pins
+	int8_t shift;                 // value << shift if the pins are in port
+	                              // bit order with no gaps, else -1
+	uint8_t count;
+	uint8_t bits[PINGROUP_MAX];   // port bit of each value bit
+} PinGroup;
+
+/*
+ * The bits of port (the digitalPinToPort() number) in mask take their
+ * values from value in one access, the others are left alone; no interrupt
+ * sees some of them changed and not the others.
+ */
+void portWrite(uint8_t port, uint8_t mask, uint8_t value);
+uint8_t portRead(uint8_t port);
+
+/*
+ * Works out the mapping once. Returns false, and leaves a group that reads
+ * 0 and ignores writes, if there are more than eight pins or they are not
+ * all on the same port. The pins are set up with pinMode() as usual.
+ */
+bool pinGroupInit(PinGroup *group, const uint8_t *pins, uint8_t count);
+void pinGroupWrite(const PinGroup *group, uint8_t value);
+uint8_t pinGroupRead(const PinGroup *group);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // __cplusplus
+
+#endif // _PINGROUP_
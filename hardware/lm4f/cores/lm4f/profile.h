@@ -0,0 +1,122 @@
+/*
+  profile.h - Cycle counting profiler zones on the Cortex-M4 DWT cycle
+  counter
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _PROFILE_
+#define _PROFILE_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif // __cplusplus
+
+// Debug registers: DEMCR.TRCENA powers the DWT, which counts core cycles
+#define PROFILE_DEMCR           (*(volatile uint32_t *)0xE000EDFC)
+#define PROFILE_DEMCR_TRCENA    0x01000000
+#define PROFILE_DWT_CTRL        (*(volatile uint32_t *)0xE0001000)
+#define PROFILE_DWT_CYCCNTENA   0x00000001
+#define PROFILE_DWT_CYCCNT      (*(volatile uint32_t *)0xE0001004)
+
+/*
+ * Zones are statics that join the list profileDump() prints the first
+ * time they are measured. Times are in CPU cycles, less what reading the
+ * counter twice costs; one measurement must stay below 2^32 cycles
+ * (53 s at 80 MHz).
+ */
+typedef struct ProfileZone {
+	struct ProfileZone *next;
+	const char *name;
+	uint32_t count;
+	uint32_t min;
+	uint32_t max;
+	uint64_t total;
+} ProfileZone;
+
+#define PROFILE_ZONE_INIT(name) { 0, (name), 0, 0xFFFFFFFF, 0, 0 }
+#define PROFILE_ZONE(zone, name) ProfileZone zone = PROFILE_ZONE_INIT(name)
+
+static inline uint32_t profileCycles(void)
+{
+	return PROFILE_DWT_CYCCNT;
+}
+
+/*
+ *   static PROFILE_ZONE(parse, "parse");
+ *   ...
+ *   PROFILE_BEGIN(parse);
+ *   parseLine(buffer);
+ *   PROFILE_END(parse);
+ */
+#define PROFILE_BEGIN(zone)     uint32_t zone##Start = profileCycles()
+#define PROFILE_END(zone)       profileAdd(&(zone), profileCycles() - zone##Start)
+
+// Starts the cycle counter, from main() before setup()
+void profileInit(void);
+
+// Adds one measurement to a zone, also from interrupts
+void profileAdd(ProfileZone *zone, uint32_t cycles);
+
+// Clears the counts of all zones
+void profileReset(void);
+
+/*
+ * Prints every zone as a tab separated line between "#profile <F_CPU>"
+ * and "#end" on Serial:
+ *   name  count  min  max  total
+ * hardware/tools/profile_report.py turns that into a sorted report.
+ */
+void profileDump(void);
+
+#ifdef __cplusplus
+} // extern "C"
+
+// Measures the rest of the enclosing block
+class ProfileScope
+{
+	public:
+		ProfileScope(ProfileZone *zone) : _zone(zone), _start(profileCycles()) {}
+		~ProfileScope() { profileAdd(_zone, profileCycles() - _start); }
+	private:
+		ProfileZone *_zone;
+		uint32_t _start;
+};
+
+#define PROFILE_CONCAT_(a, b)   a##b
+#define PROFILE_CONCAT(a, b)    PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(name)                                                 \
+	static PROFILE_ZONE(PROFILE_CONCAT(profileZone, __LINE__), name);       \
+	ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(                    \
+		&PROFILE_CONCAT(profileZone, __LINE__))
+#endif // __cplusplus
+
+/*
+ * The core drivers (Serial, SPI, Wire, lwIP input) measure themselves when
+ * built with -DPROFILE_DRIVERS; otherwise these compile to nothing.
+ */
+#ifdef PROFILE_DRIVERS
+#define PROFILE_DRIVER_SCOPE(name)          PROFILE_SCOPE(name)
+#define PROFILE_DRIVER_BEGIN(zone, name)    static PROFILE_ZONE(zone, name); PROFILE_BEGIN(zone)
+#define PROFILE_DRIVER_END(zone)            PROFILE_END(zone)
+#else
+#define PROFILE_DRIVER_SCOPE(name)
+#define PROFILE_DRIVER_BEGIN(zone, name)
+#define PROFILE_DRIVER_END(zone)
+#endif
+
+#endif // _PROFILE_
@@ -95,6 +95,27 @@ __attribute__((weak)) void UARTIntHandler7(void) {}
 __attribute__((weak)) void ToneIntHandler(void) {}
 __attribute__((weak)) void I2CIntHandler(void) {}
 __attribute__((weak)) void Timer5IntHandler(void) {}
+__attribute__((weak)) void ADC1Seq0IntHandler(void) {}
+__attribute__((weak)) void Timer0AIntHandler(void) {}
+__attribute__((weak)) void Timer0BIntHandler(void) {}
+__attribute__((weak)) void Timer1AIntHandler(void) {}
+__attribute__((weak)) void Timer1BIntHandler(void) {}
+__attribute__((weak)) void Timer2AIntHandler(void) {}
+__attribute__((weak)) void Timer2BIntHandler(void) {}
+__attribute__((weak)) void Timer3AIntHandler(void) {}
+__attribute__((weak)) void Timer3BIntHandler(void) {}
+#ifdef TARGET_IS_BLIZZARD_RB1
+__attribute__((weak)) void WideTimer0AIntHandler(void) {}
+__attribute__((weak)) void WideTimer0BIntHandler(void) {}
+__attribute__((weak)) void WideTimer1AIntHandler(void) {}
+__attribute__((weak)) void WideTimer1BIntHandler(void) {}
+__attribute__((weak)) void WideTimer2AIntHandler(void) {}
+__attribute__((weak)) void WideTimer2BIntHandler(void) {}
+__attribute__((weak)) void WideTimer3AIntHandler(void) {}
+__attribute__((weak)) void WideTimer3BIntHandler(void) {}
+__attribute__((weak)) void WideTimer5AIntHandler(void) {}
+__attribute__((weak)) void WideTimer5BIntHandler(void) {}
+#endif
 //*****************************************************************************
 // System stack start determined by ldscript, normally highest ram address
 //*****************************************************************************
@@ -146,12 +167,12 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // ADC Sequence 2
     IntDefaultHandler,                      // ADC Sequence 3
     IntDefaultHandler,                      // Watchdog timer
-    IntDefaultHandler,                      // Timer 0 subtimer A
-    IntDefaultHandler,                      // Timer 0 subtimer B
-    IntDefaultHandler,                      // Timer 1 subtimer A
-    IntDefaultHandler,                      // Timer 1 subtimer B
-    IntDefaultHandler,                      // Timer 2 subtimer A
-    IntDefaultHandler,                      // Timer 2 subtimer B
+    Timer0AIntHandler,                      // Timer 0 subtimer A
+    Timer0BIntHandler,                      // Timer 0 subtimer B
+    Timer1AIntHandler,                      // Timer 1 subtimer A
+    Timer1BIntHandler,                      // Timer 1 subtimer B
+    Timer2AIntHandler,                      // Timer 2 subtimer A
+    Timer2BIntHandler,                      // Timer 2 subtimer B
     IntDefaultHandler,                      // Analog Comparator 0
     IntDefaultHandler,                      // Analog Comparator 1
     IntDefaultHandler,                      // Analog Comparator 2
@@ -162,8 +183,8 @@ void (* const g_pfnVectors[])(void) =
     GPIOHIntHandler,                        // GPIO Port H
     UARTIntHandler2,                        // UART2 Rx and Tx
     IntDefaultHandler,                      // SSI1 Rx and Tx
-    IntDefaultHandler,                      // Timer 3 subtimer A
-    IntDefaultHandler,                      // Timer 3 subtimer B
+    Timer3AIntHandler,                      // Timer 3 subtimer A
+    Timer3BIntHandler,                      // Timer 3 subtimer B
     I2CIntHandler,                          // I2C1 Master and Slave
     IntDefaultHandler,                      // Quadrature Encoder 1
     IntDefaultHandler,                      // CAN0
@@ -175,7 +196,7 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // PWM Generator 3
     IntDefaultHandler,                      // uDMA Software Transfer
     IntDefaultHandler,                      // uDMA Error
-    IntDefaultHandler,                      // ADC1 Sequence 0
+    ADC1Seq0IntHandler,                     // ADC1 Sequence 0
     IntDefaultHandler,                      // ADC1 Sequence 1
     IntDefaultHandler,                      // ADC1 Sequence 2
     IntDefaultHandler,                      // ADC1 Sequence 3
@@ -221,18 +242,18 @@ void (* const g_pfnVectors[])(void) =
     0,                                      // Reserved
     Timer5IntHandler,                       // Timer 5 subtimer A
     IntDefaultHandler,                      // Timer 5 subtimer B
-    IntDefaultHandler,                      // Wide Timer 0 subtimer A
-    IntDefaultHandler,                      // Wide Timer 0 subtimer B
-    IntDefaultHandler,                      // Wide Timer 1 subtimer A
-    IntDefaultHandler,                      // Wide Timer 1 subtimer B
-    IntDefaultHandler,                      // Wide Timer 2 subtimer A
-    IntDefaultHandler,                      // Wide Timer 2 subtimer B
-    IntDefaultHandler,                      // Wide Timer 3 subtimer A
-    IntDefaultHandler,                      // Wide Timer 3 subtimer B
+    WideTimer0AIntHandler,                  // Wide Timer 0 subtimer A
+    WideTimer0BIntHandler,                  // Wide Timer 0 subtimer B
+    WideTimer1AIntHandler,                  // Wide Timer 1 subtimer A
+    WideTimer1BIntHandler,                  // Wide Timer 1 subtimer B
+    WideTimer2AIntHandler,                  // Wide Timer 2 subtimer A
+    WideTimer2BIntHandler,                  // Wide Timer 2 subtimer B
+    WideTimer3AIntHandler,                  // Wide Timer 3 subtimer A
+    WideTimer3BIntHandler,                  // Wide Timer 3 subtimer B
     IntDefaultHandler,                      // Wide Timer 4 subtimer A
     IntDefaultHandler,                      // Wide Timer 4 subtimer B
-    IntDefaultHandler,                      // Wide Timer 5 subtimer A
-    IntDefaultHandler,                      // Wide Timer 5 subtimer B
+    WideTimer5AIntHandler,                  // Wide Timer 5 subtimer A
+    WideTimer5BIntHandler,                  // Wide Timer 5 subtimer B
     IntDefaultHandler,                      // FPU
     IntDefaultHandler,                      // PECI 0
     IntDefaultHandler,                      // LPC 0
@@ -306,12 +327,12 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // ADC Sequence 2
     IntDefaultHandler,                      // ADC Sequence 3
     IntDefaultHandler,                      // Watchdog timer
-    IntDefaultHandler,                      // Timer 0 subtimer A
-    IntDefaultHandler,                      // Timer 0 subtimer B
-    IntDefaultHandler,                      // Timer 1 subtimer A
-    IntDefaultHandler,                      // Timer 1 subtimer B
-    IntDefaultHandler,                      // Timer 2 subtimer A
-    IntDefaultHandler,                      // Timer 2 subtimer B
+    Timer0AIntHandler,                      // Timer 0 subtimer A
+    Timer0BIntHandler,                      // Timer 0 subtimer B
+    Timer1AIntHandler,                      // Timer 1 subtimer A
+    Timer1BIntHandler,                      // Timer 1 subtimer B
+    Timer2AIntHandler,                      // Timer 2 subtimer A
+    Timer2BIntHandler,                      // Timer 2 subtimer B
     IntDefaultHandler,                      // Analog Comparator 0
     IntDefaultHandler,                      // Analog Comparator 1
     IntDefaultHandler,                      // Analog Comparator 2
@@ -322,8 +343,8 @@ void (* const g_pfnVectors[])(void) =
     GPIOHIntHandler,                        // GPIO Port H
     UARTIntHandler2,                        // UART2 Rx and Tx
     IntDefaultHandler,                      // SSI1 Rx and Tx
-    IntDefaultHandler,                      // Timer 3 subtimer A
-    IntDefaultHandler,                      // Timer 3 subtimer B
+    Timer3AIntHandler,                      // Timer 3 subtimer A
+    Timer3BIntHandler,                      // Timer 3 subtimer B
     IntDefaultHandler,                      // I2C1 Master and Slave
     IntDefaultHandler,                      // CAN0
     IntDefaultHandler,                      // CAN1
@@ -333,7 +354,7 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // PWM Generator 3
     IntDefaultHandler,                      // uDMA Software Transfer
     IntDefaultHandler,                      // uDMA Error
-    IntDefaultHandler,                      // ADC1 Sequence 0
+    ADC1Seq0IntHandler,                     // ADC1 Sequence 0
     IntDefaultHandler,                      // ADC1 Sequence 1
     IntDefaultHandler,                      // ADC1 Sequence 2
     IntDefaultHandler,                      // ADC1 Sequence 3
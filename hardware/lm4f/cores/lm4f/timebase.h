@@ -0,0 +1,82 @@
+/*
+  timebase.h - Arithmetic behind millis(), micros(), micros64() and nanos()
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+/*
+ * Timer5 counts up at F_CPU, concatenated to 32 bits, and wraps after a
+ * whole number of milliseconds: about 35 s at 120 MHz and 53 s at 80 MHz.
+ * Its wrap interrupt, counting the wraps, is the only interrupt the
+ * timebase takes. The time is the wrap count and the counter value,
+ * turned into units with 32 bit divisions by constants, which the
+ * compiler does with a multiply.
+ *
+ * Nothing here touches the hardware, so it can be checked on any host
+ * with F_CPU defined.
+ */
+
+#ifndef _TIMEBASE_
+#define _TIMEBASE_
+
+#include <stdint.h>
+
+#define TIMEBASE_CYCLES_PER_US  (F_CPU / 1000000UL)
+#define TIMEBASE_CYCLES_PER_MS  (F_CPU / 1000UL)
+#define TIMEBASE_WRAP_MS        (0xFFFFFFFFUL / TIMEBASE_CYCLES_PER_MS)
+#define TIMEBASE_WRAP_CYCLES    (TIMEBASE_WRAP_MS * TIMEBASE_CYCLES_PER_MS)
+
+// Wraps to count for a counter value read while the wrap interrupt was
+// pending or not. A wrap that happened before the read leaves a small
+// counter value, one that happened just after it a large one. This holds
+// as long as the interrupt is not held off for half a wrap period.
+static inline uint32_t timebaseWraps(uint32_t wraps, uint32_t count, int pending)
+{
+	return wraps + (pending && count < TIMEBASE_WRAP_CYCLES / 2);
+}
+
+// Cycles from start to now, two counter values read less than a wrap
+// period apart
+static inline uint32_t timebaseElapsed(uint32_t start, uint32_t now)
+{
+	return now - start + (now < start ? TIMEBASE_WRAP_CYCLES : 0);
+}
+
+static inline uint32_t timebaseMillis(uint32_t wraps, uint32_t count)
+{
+	return wraps * TIMEBASE_WRAP_MS + count / TIMEBASE_CYCLES_PER_MS;
+}
+
+static inline uint32_t timebaseMicros(uint32_t wraps, uint32_t count)
+{
+	return wraps * (TIMEBASE_WRAP_MS * 1000) + count / TIMEBASE_CYCLES_PER_US;
+}
+
+static inline uint64_t timebaseMicros64(uint32_t wraps, uint32_t count)
+{
+	return (uint64_t)wraps * (TIMEBASE_WRAP_MS * 1000) +
+	       count / TIMEBASE_CYCLES_PER_US;
+}
+
+static inline uint64_t timebaseNanos(uint32_t wraps, uint32_t count)
+{
+	uint32_t us = count / TIMEBASE_CYCLES_PER_US;
+	uint32_t cycles = count - us * TIMEBASE_CYCLES_PER_US;
+
+	return ((uint64_t)wraps * (TIMEBASE_WRAP_MS * 1000) + us) * 1000 +
+	       cycles * 1000 / TIMEBASE_CYCLES_PER_US;
+}
+
+#endif
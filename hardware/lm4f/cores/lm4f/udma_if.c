@@ -0,0 +1,53 @@
+/*
+  ************************************************************************
+  *	udma_if.c
+  *
+  *	Shared uDMA controller setup for the lm4f core
+  *
+  ***********************************************************************
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "Energia.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "driverlib/rom.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/udma.h"
+#include "udma_if.h"
+
+//*****************************************************************************
+//
+// The uDMA channel control table. The controller requires it to be aligned
+// on a 1024 byte boundary; it holds the primary and alternate structures for
+// all 32 channels.
+//
+//*****************************************************************************
+static tDMAControlTable udmaControlTable[64] __attribute__ ((aligned(1024)));
+
+static uint8_t udmaInitialized = 0;
+
+void UDMAInit(void)
+{
+    if(udmaInitialized)
+        return;
+
+    ROM_SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+    ROM_uDMAEnable();
+    ROM_uDMAControlBaseSet(udmaControlTable);
+
+    udmaInitialized = 1;
+}
@@ -0,0 +1,45 @@
+/*
+  ************************************************************************
+  *	udma_if.h
+  *
+  *	Shared uDMA controller setup for the lm4f core
+  *
+  ***********************************************************************
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef udma_if_h
+#define udma_if_h
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//
+// Enable the uDMA controller and install the channel control table.
+// Safe to call more than once; only the first call touches the hardware.
+// Drivers call this from their DMA enable path only so that the 1K control
+// table is not linked into sketches that never use uDMA.
+//
+void UDMAInit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
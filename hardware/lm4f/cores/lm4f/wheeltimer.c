@@ -0,0 +1,313 @@
+/*
+  wheeltimer.c - Software timers on a hierarchical timer wheel, one tick
+  per millisecond of millis()
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <stddef.h>
+#include "Energia.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_timer.h"
+#include "inc/hw_types.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/rom.h"
+#include "driverlib/timer.h"
+#include "wheeltimer.h"
+#include "timebase.h"
+
+/*
+ * Four levels of 64 slots. Level 0 holds the timers due in the next 64
+ * ticks, one slot per tick; level n those due within 64^(n+1) ticks, one
+ * slot per 64^n. Each time level n wraps, the next slot of level n+1 is
+ * spread over the levels below. Timers further out than the top level
+ * reaches (about 4.6 hours) are parked in its last slot and placed again
+ * when it comes round.
+ *
+ * There is no interrupt per tick. A Timer5 match (see timebase.h) is set
+ * for the next tick with work, a timer due or a cascade that moves timers,
+ * and pends SysTick; its handler runs the ticks up to millis() and sets
+ * the next match. Ticks without work in between are skipped. SysTick does
+ * not count, it only gives the callbacks their interrupt priority.
+ */
+#define WHEEL_BITS      6
+#define WHEEL_SIZE      (1 << WHEEL_BITS)
+#define WHEEL_MASK      (WHEEL_SIZE - 1)
+#define WHEEL_LEVELS    4
+#define WHEEL_SPAN      ((1UL << (WHEEL_BITS * WHEEL_LEVELS)) - 1)
+#define WHEEL_LOOKAHEAD (WHEEL_SIZE * WHEEL_SIZE)       // ticks, about 4 s
+
+static WheelTimer *wheel[WHEEL_LEVELS][WHEEL_SIZE];
+static uint32_t wheelNext;              // tick the wheel will process next
+static unsigned long wheelCount;        // timers started
+static WheelTimer *volatile deferList;   // timers owed a wheelTimerRun()
+
+// The Timer5 match only interrupts while there are timers
+static void wheelIdle(bool idle)
+{
+	if (idle) {
+		ROM_TimerIntDisable(TIMER5_BASE, TIMER_TIMA_MATCH);
+	} else {
+		ROM_TimerIntClear(TIMER5_BASE, TIMER_TIMA_MATCH);
+		ROM_TimerIntEnable(TIMER5_BASE, TIMER_TIMA_MATCH);
+	}
+}
+
+static void wheelAdd(WheelTimer *timer)
+{
+	uint32_t expires = timer->expires;
+	uint32_t delta = expires - wheelNext;
+	WheelTimer **slot;
+	unsigned int level;
+
+	if ((int32_t)delta < 0) {
+		// overdue, run on the next tick
+		slot = &wheel[0][wheelNext & WHEEL_MASK];
+	} else {
+		if (delta > WHEEL_SPAN) {
+			expires = wheelNext + WHEEL_SPAN;
+			delta = WHEEL_SPAN;
+		}
+		for (level = 0; delta >> (WHEEL_BITS * (level + 1)); level++)
+			;
+		slot = &wheel[level][(expires >> (WHEEL_BITS * level)) & WHEEL_MASK];
+	}
+
+	timer->next = *slot;
+	if (timer->next)
+		timer->next->pprev = &timer->next;
+	*slot = timer;
+	timer->pprev = slot;
+}
+
+static void wheelRemove(WheelTimer *timer)
+{
+	*timer->pprev = timer->next;
+	if (timer->next)
+		timer->next->pprev = timer->pprev;
+	timer->pprev = NULL;
+}
+
+// Spread the current slot of a level over the levels below, returns the
+// slot index so the caller knows whether this level wrapped as well
+static unsigned int wheelCascade(unsigned int level)
+{
+	unsigned int index = (wheelNext >> (WHEEL_BITS * level)) & WHEEL_MASK;
+	WheelTimer *timer = wheel[level][index], *next;
+
+	wheel[level][index] = NULL;
+	for (; timer; timer = next) {
+		next = timer->next;
+		wheelAdd(timer);
+	}
+	return index;
+}
+
+// True if the cascade at tick, the start of a level 0 lap, moves timers
+static bool wheelCascadeDue(uint32_t tick)
+{
+	unsigned int level, index;
+
+	for (level = 1; level < WHEEL_LEVELS; level++) {
+		index = (tick >> (WHEEL_BITS * level)) & WHEEL_MASK;
+		if (wheel[level][index])
+			return true;
+		if (index != 0)
+			break;
+	}
+	return false;
+}
+
+// The first tick from wheelNext on with work, or the end of the look ahead
+static uint32_t wheelWork(void)
+{
+	uint32_t tick = wheelNext;
+	unsigned int i;
+
+	for (i = 0; i < WHEEL_SIZE; i++, tick++) {
+		if ((tick & WHEEL_MASK) == 0 && wheelCascadeDue(tick))
+			return tick;
+		if (wheel[0][tick & WHEEL_MASK])
+			return tick;
+	}
+
+	// Level 0 is done with, only cascades are left
+	tick = (tick + WHEEL_MASK) & ~(uint32_t)WHEEL_MASK;
+	for (; tick - wheelNext < WHEEL_LOOKAHEAD; tick += WHEEL_SIZE) {
+		if (wheelCascadeDue(tick))
+			return tick;
+	}
+	return tick;
+}
+
+// Sets the Timer5 match to the start of the next tick with work, or pends
+// SysTick at once if that tick has begun
+static void wheelArm(void)
+{
+	uint32_t tick = wheelWork();
+	uint32_t count = HWREG(TIMER5_BASE + TIMER_O_TAV);
+	int32_t ahead = tick - millis();        // read after count: errs early
+	uint32_t match;
+
+	if (ahead <= 0) {
+		ROM_IntPendSet(FAULT_SYSTICK);
+		return;
+	}
+
+	match = (count / TIMEBASE_CYCLES_PER_MS + ahead) % TIMEBASE_WRAP_MS *
+		TIMEBASE_CYCLES_PER_MS;
+	if (match == 0)
+		match = 1;                      // the reload, which does not match
+	ROM_TimerIntClear(TIMER5_BASE, TIMER_TIMA_MATCH);
+	HWREG(TIMER5_BASE + TIMER_O_TAMATCHR) = match;
+
+	// Passed while it was being set
+	if (timebaseElapsed(count, HWREG(TIMER5_BASE + TIMER_O_TAV)) >=
+	    timebaseElapsed(count, match))
+		ROM_IntPendSet(FAULT_SYSTICK);
+}
+
+void wheelTimerInit(WheelTimer *timer, WheelTimerCallback callback, void *arg,
+                   uint8_t flags)
+{
+	timer->next = NULL;
+	timer->pprev = NULL;
+	timer->deferNext = NULL;
+	timer->callback = callback;
+	timer->arg = arg;
+	timer->flags = flags;
+	timer->deferred = 0;
+}
+
+void wheelTimerStart(WheelTimer *timer, uint32_t ms, uint32_t period)
+{
+	bool wasDisabled = ROM_IntMasterDisable();
+	uint32_t now = millis();
+
+	if (timer->pprev) {
+		wheelRemove(timer);
+	} else if (wheelCount++ == 0) {
+		wheelNext = now;                // the wheel stands still while idle
+		wheelIdle(false);
+	}
+	timer->expires = now + ms;
+	timer->period = period;
+	wheelAdd(timer);
+	wheelArm();
+
+	if (!wasDisabled)
+		ROM_IntMasterEnable();
+}
+
+void wheelTimerStop(WheelTimer *timer)
+{
+	bool wasDisabled = ROM_IntMasterDisable();
+
+	if (timer->pprev) {
+		wheelRemove(timer);
+		if (--wheelCount == 0)
+			wheelIdle(true);
+	}
+
+	if (!wasDisabled)
+		ROM_IntMasterEnable();
+}
+
+bool wheelTimerActive(const WheelTimer *timer)
+{
+	return timer->pprev != NULL;
+}
+
+// Processes the tick at wheelNext
+static void wheelTick(void)
+{
+	unsigned int index = wheelNext & WHEEL_MASK;
+	unsigned int level;
+	WheelTimer *work, *timer;
+
+	for (level = 1; index == 0 && level < WHEEL_LEVELS; level++) {
+		if (wheelCascade(level) != 0)
+			break;
+	}
+
+	// Take the slot out of the wheel, so the callbacks can start and stop
+	// timers (the ones in it included) freely
+	work = wheel[0][index];
+	wheel[0][index] = NULL;
+	if (work)
+		work->pprev = &work;
+	wheelNext++;
+
+	while ((timer = work) != NULL) {
+		wheelRemove(timer);
+		if (timer->period) {
+			timer->expires += timer->period;
+			wheelAdd(timer);
+		} else if (--wheelCount == 0) {
+			wheelIdle(true);
+		}
+
+		if (timer->flags & WHEELTIMER_DEFER) {
+			if (timer->deferred++ == 0) {
+				timer->deferNext = deferList;
+				deferList = timer;
+			}
+		} else {
+			timer->callback(timer->arg);
+		}
+	}
+}
+
+void wheelTimerTick(void)
+{
+	uint32_t now = millis();
+	uint32_t tick;
+
+	while (wheelCount) {
+		// The ticks before it have nothing to do
+		tick = wheelWork();
+		if ((int32_t)(tick - now) > 0) {
+			wheelArm();
+			break;
+		}
+		wheelNext = tick;
+		wheelTick();
+	}
+}
+
+void wheelTimerRun(void)
+{
+	WheelTimer *timer, *next;
+	uint8_t runs;
+
+	if (!deferList)
+		return;
+
+	ROM_IntMasterDisable();
+	timer = deferList;
+	deferList = NULL;
+	ROM_IntMasterEnable();
+
+	for (; timer; timer = next) {
+		ROM_IntMasterDisable();
+		next = timer->deferNext;
+		runs = timer->deferred;
+		timer->deferred = 0;
+		ROM_IntMasterEnable();
+		while (runs--)
+			timer->callback(timer->arg);
+	}
+}
@@ -34,17 +34,14 @@
 #include "driverlib/rom.h"
 #include "driverlib/sysctl.h"
 #include "driverlib/timer.h"
+#include "wiring_private.h"
+#include "timebase.h"
+#include "wheeltimer.h"
+#include "cotask.h"
 
-static void (*SysTickCbFuncs[8])(uint32_t ui32TimeMS);
+#define SYSTICKCBMS             10
 
-#define SYSTICKMS               (1000 / SYSTICKHZ)
-#define SYSTICKHZ               100
-
-#ifndef TIMER5DELAY
-#define TIMER5DELAY 1000 
-#endif
-
-static unsigned long milliseconds = 0;
+static volatile unsigned long timebaseWrapCount = 0;
 #define SYSTICK_INT_PRIORITY    0x80
 void timerInit()
 {
@@ -62,20 +59,20 @@ void timerInit()
 #endif
 
     //
-    //  SysTick is used for delay() and delayMicroseconds()
+    //  SysTick does not count. The software timers pend it when one is
+    //  due, so their callbacks run at its priority, see wheeltimer.c
     //
-
-    ROM_SysTickPeriodSet(F_CPU / SYSTICKHZ);
-    ROM_SysTickEnable();
     ROM_IntPrioritySet(FAULT_SYSTICK, SYSTICK_INT_PRIORITY);
-    ROM_SysTickIntEnable();
     //
-    //Initialize Timer5 to be used as time-tracker since beginning of time
+    //Initialize Timer5 to be used as time-tracker since beginning of time.
+    //It runs free and only interrupts when it wraps, see timebase.h, and
+    //at the match the software timers set while they are started
     //
     ROM_SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER5); //not tied to launchpad pin
     ROM_TimerConfigure(TIMER5_BASE, TIMER_CFG_PERIODIC_UP);
+    HWREG(TIMER5_BASE + TIMER_O_TAMR) |= TIMER_TAMR_TAMIE;
 
-    ROM_TimerLoadSet(TIMER5_BASE, TIMER_A, F_CPU/TIMER5DELAY);
+    ROM_TimerLoadSet(TIMER5_BASE, TIMER_A, TIMEBASE_WRAP_CYCLES - 1);
 
     ROM_IntEnable(INT_TIMER5A);
     ROM_TimerIntEnable(TIMER5_BASE, TIMER_TIMA_TIMEOUT);
@@ -86,32 +83,80 @@ void timerInit()
 
 }
 
+//
+// Reads the wrap count and Timer5 as one value. If the wrap interrupt
+// runs meanwhile the read is repeated; if it cannot run (interrupts
+// off, or called from a higher priority handler) a pending wrap is
+// counted here.
+//
+static unsigned long timebaseRead(unsigned long *count)
+{
+	unsigned long wraps, pending;
+
+	do {
+		wraps = timebaseWrapCount;
+		*count = HWREG(TIMER5_BASE + TIMER_O_TAV);
+		pending = HWREG(TIMER5_BASE + TIMER_O_RIS) & TIMER_RIS_TATORIS;
+	} while (wraps != timebaseWrapCount);
+
+	return timebaseWraps(wraps, *count, pending);
+}
+
 unsigned long micros(void)
 {
-	return (milliseconds * 1000) + (HWREG(TIMER5_BASE + TIMER_O_TAV) / (F_CPU/1000000));
+	unsigned long count, wraps = timebaseRead(&count);
+	return timebaseMicros(wraps, count);
 }
 
 unsigned long millis(void)
 {
-	return milliseconds;
+	unsigned long count, wraps = timebaseRead(&count);
+	return timebaseMillis(wraps, count);
+}
+
+uint64_t micros64(void)
+{
+	unsigned long count, wraps = timebaseRead(&count);
+	return timebaseMicros64(wraps, count);
 }
 
+uint64_t nanos(void)
+{
+	unsigned long count, wraps = timebaseRead(&count);
+	return timebaseNanos(wraps, count);
+}
+
+//
+// Counts Timer5 cycles, in steps short enough for the count to fit
+// within one Timer5 wrap
+//
 void delayMicroseconds(unsigned int us)
 {
-	volatile unsigned long elapsedTime;
-	unsigned long startTime = HWREG(NVIC_ST_CURRENT);
-	do{
-		elapsedTime = startTime-(HWREG(NVIC_ST_CURRENT) & 0x00FFFFFF);
+	unsigned long start, now, elapsed, cycles, step;
+
+	while(us) {
+		step = us < 1000000 ? us : 1000000;
+		us -= step;
+		cycles = step * TIMEBASE_CYCLES_PER_US;
+		start = HWREG(TIMER5_BASE + TIMER_O_TAV);
+		do {
+			now = HWREG(TIMER5_BASE + TIMER_O_TAV);
+			elapsed = timebaseElapsed(start, now);
+		} while(elapsed < cycles);
 	}
-	while(elapsedTime <= us * (F_CPU/1000000));
 }
 
 void delay(uint32_t ms)
 {
-	unsigned long i;
-	for(i=0; i<ms; i++){
-		delayMicroseconds(1000);
-	}
+	uint64_t end = micros64() + (uint64_t)ms * 1000;
+	int tasks = !currentException();
+
+	// Tasks run while we wait, so the time they take is not added on.
+	// Not when delay() is called from a handler, which may have
+	// interrupted one of them.
+	while(micros64() < end)
+		if(tasks)
+			coTaskRun();
 }
 
 volatile boolean stay_asleep = false;
@@ -151,17 +196,39 @@ void suspend(void)
 
 void Timer5IntHandler(void)
 {
+	unsigned long status = ROM_TimerIntStatus(TIMER5_BASE, true);
+
+	ROM_TimerIntClear(TIMER5_BASE, status);
+	if (status & TIMER_TIMA_TIMEOUT)
+		timebaseWrapCount++;
+	if (status & TIMER_TIMA_MATCH)
+		ROM_IntPendSet(FAULT_SYSTICK);  // a software timer tick is due
+}
+
+//
+// The old fixed table of SysTick callbacks, now periodic software timers
+// calling back every SYSTICKCBMS
+//
+static struct {
+	WheelTimer timer;
+	void (*func)(uint32_t ui32TimeMS);
+} SysTickCbs[8];
 
-    ROM_TimerIntClear(TIMER5_BASE, TIMER_TIMA_TIMEOUT);
-	milliseconds++;
+static void SysTickCbRun(void *arg)
+{
+	SysTickCbs[(uintptr_t)arg].func(SYSTICKCBMS);
 }
 
 void registerSysTickCb(void (*userFunc)(uint32_t))
 {
-	uint8_t i;
+	uintptr_t i;
 	for (i=0; i<8; i++) {
-		if(!SysTickCbFuncs[i]) {
-			SysTickCbFuncs[i] = userFunc;
+		if(SysTickCbs[i].func == userFunc)
+			break;
+		if(!SysTickCbs[i].func) {
+			SysTickCbs[i].func = userFunc;
+			wheelTimerInit(&SysTickCbs[i].timer, SysTickCbRun, (void *)i, 0);
+			wheelTimerStart(&SysTickCbs[i].timer, SYSTICKCBMS, SYSTICKCBMS);
 			break;
 		}
 	}
@@ -169,9 +236,5 @@ void registerSysTickCb(void (*userFunc)(uint32_t))
 
 void SysTickIntHandler(void)
 {
-	uint8_t i;
-	for (i=0; i<8; i++) {
-		if (SysTickCbFuncs[i])
-			SysTickCbFuncs[i](SYSTICKMS);
-	}
+	wheelTimerTick();
 }
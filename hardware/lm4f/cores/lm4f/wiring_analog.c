@@ -34,6 +34,8 @@
 #include "inc/hw_types.h"
 #include "inc/hw_timer.h"
 #include "inc/hw_ints.h"
+#include "inc/hw_adc.h"
+#include "inc/hw_gpio.h"
 #include "driverlib/adc.h"
 #include "driverlib/gpio.h"
 #include "driverlib/sysctl.h"
@@ -124,6 +126,7 @@ void PWMWrite(uint8_t pin, uint32_t analog_res, uint32_t duty, unsigned int freq
         uint32_t timerAB = TIMER_A << timerToAB(timer);
 
         if (port == NOT_A_PORT) return; 	// pin on timer?
+        if (timerBase == TIMER5_BASE) return;	// the millis()/micros() timebase
 
 #ifdef __TM4C1294NCPDT__
         uint32_t periodPWM = F_CPU/freq;
@@ -175,24 +178,105 @@ void analogWrite(uint8_t pin, int val) {
     PWMWrite(pin, 255, val, 490);
 }
 
+/*
+ * ADC0 is set up once. Sequencer 3 serves analogRead() and keeps the
+ * channel of the last read, sequencer 0 serves analogReadMulti() and keeps
+ * its last list, so reading the same pins again only triggers and waits.
+ */
+static bool adcEnabled;
+static uint32_t adcChannel = NOT_ON_ADC;
+static uint8_t adcMultiCount;
+static uint32_t adcMultiChannels[8];
+
+static void adcEnable(void) {
+    if (adcEnabled) return;
+    ROM_SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
+    while (!ROM_SysCtlPeripheralReady(SYSCTL_PERIPH_ADC0)) {
+    }
+    ROM_ADCSequenceConfigure(ADC0_BASE, 3, ADC_TRIGGER_PROCESSOR, 0);
+    ROM_ADCSequenceConfigure(ADC0_BASE, 0, ADC_TRIGGER_PROCESSOR, 0);
+    adcEnabled = true;
+}
+
+// pinMode() may have taken the pin back since it was last read
+static void adcPinSetup(uint8_t pin) {
+    uint32_t portBase = (uint32_t) portBASERegister(digitalPinToPort(pin));
+    uint8_t bit = digitalPinToBitMask(pin);
+
+    if (!(HWREG(portBase + GPIO_O_AMSEL) & bit) || !(HWREG(portBase + GPIO_O_AFSEL) & bit))
+        ROM_GPIOPinTypeADC(portBase, bit);
+}
+
+static void adcConvert(uint32_t sequence) {
+    HWREG(ADC0_BASE + ADC_O_ISC) = 1 << sequence;
+    HWREG(ADC0_BASE + ADC_O_PSSI) = 1 << sequence;
+    while (!(HWREG(ADC0_BASE + ADC_O_RIS) & (1 << sequence))) {
+    }
+    HWREG(ADC0_BASE + ADC_O_ISC) = 1 << sequence;
+}
+
 uint16_t analogRead(uint8_t pin) {
-    uint8_t port = digitalPinToPort(pin);
-    uint16_t value[1];
     uint32_t channel = digitalPinToADCIn(pin);
     if (channel == NOT_ON_ADC) { //invalid ADC pin
         return 0;
     }
-    ROM_SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
-    ROM_GPIOPinTypeADC((uint32_t) portBASERegister(port), digitalPinToBitMask(pin));
-    ROM_ADCSequenceConfigure(ADC0_BASE, 3, ADC_TRIGGER_PROCESSOR, 0);
-    ROM_ADCSequenceStepConfigure(ADC0_BASE, 3, 0, channel | ADC_CTL_IE | ADC_CTL_END);
-    ROM_ADCSequenceEnable(ADC0_BASE, 3);
+    adcEnable();
+    adcPinSetup(pin);
+    if (channel != adcChannel) {
+        ROM_ADCSequenceDisable(ADC0_BASE, 3);
+        ROM_ADCSequenceStepConfigure(ADC0_BASE, 3, 0, channel | ADC_CTL_IE | ADC_CTL_END);
+        ROM_ADCSequenceEnable(ADC0_BASE, 3);
+        adcChannel = channel;
+    }
+
+    adcConvert(3);
+    return HWREG(ADC0_BASE + ADC_O_SSFIFO3);
+}
+
+/*
+ * Converts up to eight pins from one trigger of sequencer 0, in order,
+ * into values. Pins not on the ADC read 0. Returns how many were
+ * converted.
+ */
+uint8_t analogReadMulti(const uint8_t *pins, uint16_t *values, uint8_t count) {
+    uint32_t channels[8];
+    uint8_t map[8];
+    uint8_t i, n = 0;
 
-    ROM_ADCIntClear(ADC0_BASE, 3);
-    ROM_ADCProcessorTrigger(ADC0_BASE, 3);
-    while(!ROM_ADCIntStatus(ADC0_BASE, 3, false)) {
+    if (count > 8) count = 8;
+    for (i = 0; i < count; i++) {
+        values[i] = 0;
+        if (digitalPinToADCIn(pins[i]) == NOT_ON_ADC) continue;
+        map[n] = i;
+        channels[n++] = digitalPinToADCIn(pins[i]);
     }
-	ROM_ADCIntClear(ADC0_BASE, 3);
-    ROM_ADCSequenceDataGet(ADC0_BASE, 3, (unsigned long*) value);
-    return value[0];
+    if (n == 0) return 0;
+
+    adcEnable();
+    for (i = 0; i < n; i++)
+        adcPinSetup(pins[map[i]]);
+    if (n != adcMultiCount || memcmp(channels, adcMultiChannels, n * sizeof(channels[0]))) {
+        ROM_ADCSequenceDisable(ADC0_BASE, 0);
+        for (i = 0; i < n; i++)
+            ROM_ADCSequenceStepConfigure(ADC0_BASE, 0, i,
+                channels[i] | (i == n - 1 ? ADC_CTL_IE | ADC_CTL_END : 0));
+        ROM_ADCSequenceEnable(ADC0_BASE, 0);
+        memcpy(adcMultiChannels, channels, n * sizeof(channels[0]));
+        adcMultiCount = n;
+    }
+
+    adcConvert(0);
+    for (i = 0; i < n; i++)
+        values[map[i]] = HWREG(ADC0_BASE + ADC_O_SSFIFO0);
+    return n;
+}
+
+/*
+ * Averages 2 to 64 conversions in hardware into each result, for every
+ * sequencer of ADC0; 0 or 1 turns it off. Each read takes that many
+ * conversion times.
+ */
+void analogReadOversample(uint8_t factor) {
+    adcEnable();
+    ROM_ADCHardwareOversampleConfigure(ADC0_BASE, factor > 1 ? factor : 0);
 }
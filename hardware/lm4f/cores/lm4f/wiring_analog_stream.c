@@ -0,0 +1,245 @@
+/*
+  ************************************************************************
+  *	wiring_analog_stream.c
+  *
+  *	Timer paced ADC sampling into ping-pong buffers with the uDMA
+  *
+  ***********************************************************************
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "wiring_private.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_adc.h"
+#include "driverlib/adc.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#include "driverlib/udma.h"
+#include "driverlib/rom.h"
+#include "driverlib/rom_map.h"
+#include "udma_if.h"
+
+//
+// ADC1 sequencer 0 belongs to the stream, so analogRead() on ADC0 keeps
+// working alongside it. The pacing timer is one no pin uses: Wide Timer 4
+// on TM4C123, Timer 6 on TM4C129.
+//
+#define STREAM_ADC_BASE         ADC1_BASE
+#define STREAM_DMA_CHANNEL      UDMA_CH24_ADC1_0
+#ifdef TARGET_IS_SNOWFLAKE_RA0
+#define STREAM_TIMER_BASE       TIMER6_BASE
+#define STREAM_TIMER_PERIPH     SYSCTL_PERIPH_TIMER6
+#else
+#define STREAM_TIMER_BASE       WTIMER4_BASE
+#define STREAM_TIMER_PERIPH     SYSCTL_PERIPH_WTIMER4
+#endif
+#define STREAM_MAX_RATE         1000000     // conversions per second
+
+static uint16_t *streamBuffer[2];
+static uint16_t streamSamples;
+static uint8_t streamNext;                  // 0 primary, 1 alternate
+static void (*streamCallback)(uint16_t *block, uint16_t samples);
+static uint16_t * volatile streamReady;
+static volatile unsigned long streamOverruns;
+static bool streamRunning;
+
+static void streamArm(uint8_t which)
+{
+    ROM_uDMAChannelTransferSet(STREAM_DMA_CHANNEL |
+                               (which ? UDMA_ALT_SELECT : UDMA_PRI_SELECT),
+                               UDMA_MODE_PINGPONG,
+                               (void *)(STREAM_ADC_BASE + ADC_O_SSFIFO0),
+                               streamBuffer[which], streamSamples);
+}
+
+//
+// The uDMA completion of the ADC channel arrives on the sequencer's vector.
+// Hand over every block that filled, oldest first, and arm it again behind
+// the one filling now.
+//
+void ADC1Seq0IntHandler(void)
+{
+    uint32_t select;
+
+#ifdef TARGET_IS_SNOWFLAKE_RA0
+    HWREG(STREAM_ADC_BASE + ADC_O_ISC) = ADC_ISC_DMAIN0;
+#endif
+
+    for(;;)
+    {
+        select = streamNext ? UDMA_ALT_SELECT : UDMA_PRI_SELECT;
+        if(ROM_uDMAChannelModeGet(STREAM_DMA_CHANNEL | select) != UDMA_MODE_STOP)
+        {
+            break;
+        }
+
+        if(streamCallback)
+        {
+            streamCallback(streamBuffer[streamNext], streamSamples);
+        }
+        else
+        {
+            if(streamReady)
+            {
+                streamOverruns++;
+            }
+            streamReady = streamBuffer[streamNext];
+        }
+        streamArm(streamNext);
+        streamNext ^= 1;
+    }
+
+    //
+    // Both blocks filled before we got here; the channel stopped itself.
+    //
+    if(streamRunning && !ROM_uDMAChannelIsEnabled(STREAM_DMA_CHANNEL))
+    {
+        ROM_uDMAChannelEnable(STREAM_DMA_CHANNEL);
+    }
+}
+
+bool analogStreamBegin(const uint8_t *pins, uint8_t count, uint32_t rate,
+                       uint16_t *buffer0, uint16_t *buffer1, uint16_t samples,
+                       void (*callback)(uint16_t *block, uint16_t samples))
+{
+    uint32_t channel, clock;
+    uint8_t i;
+
+    if(count == 0 || count > 8 || rate == 0 || (uint64_t)rate * count > STREAM_MAX_RATE ||
+       samples == 0 || samples > 1024 || samples % count || !buffer0 || !buffer1)
+    {
+        return false;
+    }
+    for(i = 0; i < count; i++)
+    {
+        if(digitalPinToADCIn(pins[i]) == NOT_ON_ADC)
+        {
+            return false;
+        }
+    }
+
+    analogStreamEnd();
+
+    streamBuffer[0] = buffer0;
+    streamBuffer[1] = buffer1;
+    streamSamples = samples;
+    streamNext = 0;
+    streamCallback = callback;
+    streamReady = 0;
+    streamOverruns = 0;
+
+    //
+    // Every step raises a uDMA request, so any number of pins moves one
+    // sample at a time and the blocks stay interleaved pin by pin.
+    //
+    ROM_SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC1);
+    while(!ROM_SysCtlPeripheralReady(SYSCTL_PERIPH_ADC1))
+    {
+    }
+    ROM_ADCSequenceDisable(STREAM_ADC_BASE, 0);
+    ROM_ADCSequenceConfigure(STREAM_ADC_BASE, 0, ADC_TRIGGER_TIMER, 0);
+    for(i = 0; i < count; i++)
+    {
+        channel = digitalPinToADCIn(pins[i]);
+        ROM_GPIOPinTypeADC((uint32_t) portBASERegister(digitalPinToPort(pins[i])),
+                           digitalPinToBitMask(pins[i]));
+        ROM_ADCSequenceStepConfigure(STREAM_ADC_BASE, 0, i, channel | ADC_CTL_IE |
+                                     (i == count - 1 ? ADC_CTL_END : 0));
+    }
+
+    UDMAInit();
+    ROM_uDMAChannelAssign(STREAM_DMA_CHANNEL);
+    ROM_uDMAChannelAttributeDisable(STREAM_DMA_CHANNEL, UDMA_ATTR_ALL);
+    ROM_uDMAChannelControlSet(STREAM_DMA_CHANNEL | UDMA_PRI_SELECT,
+                              UDMA_SIZE_16 | UDMA_SRC_INC_NONE |
+                              UDMA_DST_INC_16 | UDMA_ARB_1);
+    ROM_uDMAChannelControlSet(STREAM_DMA_CHANNEL | UDMA_ALT_SELECT,
+                              UDMA_SIZE_16 | UDMA_SRC_INC_NONE |
+                              UDMA_DST_INC_16 | UDMA_ARB_1);
+    streamArm(0);
+    streamArm(1);
+    ROM_uDMAChannelEnable(STREAM_DMA_CHANNEL);
+
+#ifdef TARGET_IS_SNOWFLAKE_RA0
+    MAP_ADCSequenceDMAEnable(STREAM_ADC_BASE, 0);
+    MAP_ADCIntEnableEx(STREAM_ADC_BASE, ADC_INT_DMA_SS0);
+#endif
+    ROM_ADCSequenceEnable(STREAM_ADC_BASE, 0);
+    streamRunning = true;
+    ROM_IntEnable(INT_ADC1SS0);
+
+    //
+    // The timer starts a sequence on every timeout.
+    //
+#ifdef TARGET_IS_SNOWFLAKE_RA0
+    clock = F_CPU;
+#else
+    clock = ROM_SysCtlClockGet();
+#endif
+    ROM_SysCtlPeripheralEnable(STREAM_TIMER_PERIPH);
+    while(!ROM_SysCtlPeripheralReady(STREAM_TIMER_PERIPH))
+    {
+    }
+#ifdef TARGET_IS_SNOWFLAKE_RA0
+    ROM_TimerConfigure(STREAM_TIMER_BASE, TIMER_CFG_PERIODIC);
+#else
+    // a 32 bit half, the full wide timer would load the upper word as well
+    ROM_TimerConfigure(STREAM_TIMER_BASE, TIMER_CFG_SPLIT_PAIR | TIMER_CFG_A_PERIODIC);
+#endif
+    ROM_TimerLoadSet(STREAM_TIMER_BASE, TIMER_A, clock / rate - 1);
+    MAP_TimerControlTrigger(STREAM_TIMER_BASE, TIMER_A, true);
+#ifdef TARGET_IS_SNOWFLAKE_RA0
+    MAP_TimerADCEventSet(STREAM_TIMER_BASE, TIMER_ADC_TIMEOUT_A);
+#endif
+    ROM_TimerEnable(STREAM_TIMER_BASE, TIMER_A);
+    return true;
+}
+
+uint16_t *analogStreamRead(void)
+{
+    uint16_t *block;
+    bool wasDisabled = ROM_IntMasterDisable();
+
+    block = streamReady;
+    streamReady = 0;
+    if(!wasDisabled)
+    {
+        ROM_IntMasterEnable();
+    }
+    return block;
+}
+
+unsigned long analogStreamOverruns(void)
+{
+    return streamOverruns;
+}
+
+void analogStreamEnd(void)
+{
+    if(!streamRunning)
+    {
+        return;
+    }
+    ROM_TimerDisable(STREAM_TIMER_BASE, TIMER_A);
+    ROM_IntDisable(INT_ADC1SS0);
+    streamRunning = false;
+    ROM_ADCSequenceDisable(STREAM_ADC_BASE, 0);
+    ROM_uDMAChannelDisable(STREAM_DMA_CHANNEL);
+    streamReady = 0;
+}
@@ -82,6 +82,32 @@ int digitalRead(uint8_t pin)
     return LOW;
 }
 
+/*
+ * DATA aliases of the pins the runtime path of digitalWriteFast() and
+ * digitalReadFast() has met; 0 until a pin is first used
+ */
+#define PIN_COUNT (sizeof(digital_pin_to_port) / sizeof(digital_pin_to_port[0]))
+static volatile uint32_t *pinDataAlias[PIN_COUNT];
+
+volatile uint32_t *digitalPinToDataAlias(uint8_t pin)
+{
+    volatile uint32_t *alias;
+    uint8_t port;
+
+    if (pin >= PIN_COUNT) return NULL;
+
+    alias = pinDataAlias[pin];
+    if (alias) return alias;
+
+    port = digitalPinToPort(pin);
+    if (port == NOT_A_PORT) return NULL;
+
+    // Filling in the same value again from an interrupt does no harm
+    alias = GPIO_DATA_ALIAS(port_to_base[port], digitalPinToBitMask(pin));
+    pinDataAlias[pin] = alias;
+    return alias;
+}
+
 void digitalWrite(uint8_t pin, uint8_t val)
 {
     uint8_t bit = digitalPinToBitMask(pin);
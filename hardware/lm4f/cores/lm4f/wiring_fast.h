@@ -0,0 +1,84 @@
+/*
+  wiring_fast.h - digitalWriteFast() and digitalReadFast(), single register
+  accesses through the GPIO DATA alias
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef wiring_fast_h
+#define wiring_fast_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*
+ * Address bits 9:2 of a GPIO DATA access mask the pins it touches, so each
+ * pin has its own word at port base + (bit << 2): storing 0xFF there sets
+ * just that pin, reading it gives the bit or 0.
+ */
+#define GPIO_DATA_ALIAS(base, bit)  ((volatile uint32_t *)((base) + ((bit) << 2)))
+
+/*
+ * The DATA alias of a pin, NULL if it is not a GPIO. Runtime pins are
+ * looked up once and cached in wiring_digital.c.
+ */
+volatile uint32_t *digitalPinToDataAlias(uint8_t pin);
+
+// The same for pins known at compile time, where it folds to a constant
+__attribute__((always_inline))
+static inline volatile uint32_t *digitalPinToDataAliasConst(uint8_t pin)
+{
+	static const uint32_t base[] = { PORT_TO_BASE_TABLE };
+	static const uint8_t port[] = { DIGITAL_PIN_TO_PORT_TABLE };
+	static const uint8_t bit[] = { DIGITAL_PIN_TO_BIT_MASK_TABLE };
+
+	if (pin >= sizeof(port) || port[pin] == NOT_A_PORT)
+		return NULL;
+	return GPIO_DATA_ALIAS(base[port[pin]], bit[pin]);
+}
+
+/*
+ * Like digitalWrite() and digitalRead() on a pin set up with pinMode(), but
+ * without their table lookups and ROM calls each time. With a constant pin
+ * they compile to one store or load.
+ */
+__attribute__((always_inline))
+static inline void digitalWriteFast(uint8_t pin, uint8_t val)
+{
+	volatile uint32_t *alias = __builtin_constant_p(pin) ?
+		digitalPinToDataAliasConst(pin) : digitalPinToDataAlias(pin);
+
+	if (alias)
+		*alias = val ? 0xFF : 0;
+}
+
+__attribute__((always_inline))
+static inline int digitalReadFast(uint8_t pin)
+{
+	volatile uint32_t *alias = __builtin_constant_p(pin) ?
+		digitalPinToDataAliasConst(pin) : digitalPinToDataAlias(pin);
+
+	return alias && *alias ? HIGH : LOW;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif
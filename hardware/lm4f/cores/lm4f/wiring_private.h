@@ -43,11 +43,28 @@ extern "C"{
 void PWMWrite(uint8_t pin, uint32_t analog_res, uint32_t duty, unsigned int freq);
 uint8_t getTimerInterrupt(uint8_t timer);
 uint32_t getTimerBase(uint32_t offset);
+void enableTimerPeriph(uint32_t offset);
 void ToneIntHandler(void);
 void GPIOIntHandler(void);
 
 typedef void (*voidFuncPtr)(void);
 
+// Number of the exception being handled, 0 in thread mode
+static inline uint32_t currentException(void)
+{
+    uint32_t ipsr;
+    __asm volatile ("mrs %0, ipsr" : "=r" (ipsr));
+    return ipsr & 0x1FF;
+}
+
+// True while PRIMASK keeps all configurable interrupts off
+static inline int interruptsMasked(void)
+{
+    uint32_t primask;
+    __asm volatile ("mrs %0, primask" : "=r" (primask));
+    return primask & 1;
+}
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
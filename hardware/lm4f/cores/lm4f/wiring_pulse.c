@@ -31,7 +31,286 @@
 
 #include "wiring_private.h"
 #include "pins_energia.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_timer.h"
+#include "inc/hw_ints.h"
 #include "driverlib/rom.h"
+#include "driverlib/timer.h"
+
+/*
+ * Pins on a timer CCP are measured by the timer in edge-time mode, both
+ * edges, counting down at the system clock. The interrupt turns each
+ * captured count into a DWT cycle count (profileCycles()), so widths are
+ * exact to the cycle and may be up to 2^32 cycles long although the
+ * timer itself wraps after 2^24 (2^32 on wide timers).
+ */
+#define PULSE_CHANNELS  4
+
+#define PULSE_HIGH      0x01    // a new high time was measured
+#define PULSE_LOW       0x02    // a new low time was measured
+#define PULSE_ROSE      0x04    // rise holds an edge
+#define PULSE_FELL      0x08    // fall holds an edge
+
+typedef struct {
+    uint8_t pin;                // NOT_A_PIN when the channel is free
+    uint8_t offset;             // timer_to_offset
+    uint8_t ab;                 // TIMA or TIMB: shift of the B half bits
+    uint32_t base;
+    uint32_t mask;              // what the timer counts up to
+    volatile uint32_t *level;   // DATA alias of the pin
+    uint32_t rise;
+    uint32_t fall;
+    uint32_t high;
+    uint32_t low;
+    volatile uint8_t flags;
+} PulseChannel;
+
+static PulseChannel pulseChannels[PULSE_CHANNELS];
+
+// The timers with vectors here: Timer4 plays tone(), Timer5 keeps time,
+// and Timer2 is the Servo library's whole, as one 32 bit timer
+static bool pulseTimerUsable(uint32_t offset)
+{
+#ifdef TARGET_IS_SNOWFLAKE_RA0
+    return offset <= TIMER3 && offset != TIMER2;
+#else
+    return (offset <= WTIMER3 && offset != TIMER2) || offset == WTIMER5;
+#endif
+}
+
+/*
+ * A half is free unless it runs already, analogWrite() PWM say, or the
+ * other half runs with the timer not split, where both are one timer
+ */
+static bool pulseTimerHalfFree(uint32_t base, uint8_t ab)
+{
+    uint32_t ctl = HWREG(base + TIMER_O_CTL);
+
+    if (ctl & (TIMER_CTL_TAEN << ab))
+        return false;
+    return !(ctl & (TIMER_CTL_TAEN | TIMER_CTL_TBEN)) ||
+           HWREG(base + TIMER_O_CFG) == 0x04;
+}
+
+static uint32_t pulseTimerMask(uint32_t offset)
+{
+#ifdef TARGET_IS_BLIZZARD_RB1
+    if (offset >= WTIMER0)
+        return 0xFFFFFFFF;
+#endif
+    return 0x00FFFFFF;
+}
+
+static uint32_t pulseTimerInt(uint32_t offset, uint8_t ab)
+{
+    static const uint32_t ints[][2] = {
+        {INT_TIMER0A, INT_TIMER0B}, {INT_TIMER1A, INT_TIMER1B},
+        {INT_TIMER2A, INT_TIMER2B}, {INT_TIMER3A, INT_TIMER3B},
+#ifdef TARGET_IS_BLIZZARD_RB1
+        {INT_WTIMER0A, INT_WTIMER0B}, {INT_WTIMER1A, INT_WTIMER1B},
+        {INT_WTIMER2A, INT_WTIMER2B}, {INT_WTIMER3A, INT_WTIMER3B},
+        {INT_WTIMER4A, INT_WTIMER4B}, {INT_WTIMER5A, INT_WTIMER5B},
+#endif
+    };
+
+    return ints[offset][ab ? 1 : 0];
+}
+
+static PulseChannel *pulseChannel(uint8_t pin)
+{
+    int i;
+
+    for (i = 0; i < PULSE_CHANNELS; i++)
+        if (pulseChannels[i].pin == pin)
+            return &pulseChannels[i];
+    return NULL;
+}
+
+static void pulseIntHandler(uint8_t offset, uint8_t ab)
+{
+    PulseChannel *ch = NULL;
+    uint32_t now, captured, current, edge;
+    int i;
+
+    for (i = 0; i < PULSE_CHANNELS; i++) {
+        if (pulseChannels[i].pin != NOT_A_PIN &&
+            pulseChannels[i].offset == offset && pulseChannels[i].ab == ab) {
+            ch = &pulseChannels[i];
+            break;
+        }
+    }
+    if (!ch)
+        return;
+
+    now = profileCycles();
+    current = HWREG(ch->base + (ab ? TIMER_O_TBV : TIMER_O_TAV));
+    captured = HWREG(ch->base + (ab ? TIMER_O_TBR : TIMER_O_TAR));
+    HWREG(ch->base + TIMER_O_ICR) = TIMER_ICR_CAECINT << ab;
+
+    // Counting down, so the edge was (captured - current) cycles ago
+    edge = now - ((captured - current) & ch->mask);
+
+    if (*ch->level) {
+        if (ch->flags & PULSE_FELL) {
+            ch->low = edge - ch->fall;
+            ch->flags |= PULSE_LOW;
+        }
+        ch->rise = edge;
+        ch->flags |= PULSE_ROSE;
+    } else {
+        if (ch->flags & PULSE_ROSE) {
+            ch->high = edge - ch->rise;
+            ch->flags |= PULSE_HIGH;
+        }
+        ch->fall = edge;
+        ch->flags |= PULSE_FELL;
+    }
+}
+
+void Timer0AIntHandler(void) { pulseIntHandler(TIMER0, TIMA); }
+void Timer0BIntHandler(void) { pulseIntHandler(TIMER0, TIMB); }
+void Timer1AIntHandler(void) { pulseIntHandler(TIMER1, TIMA); }
+void Timer1BIntHandler(void) { pulseIntHandler(TIMER1, TIMB); }
+void Timer2AIntHandler(void) { pulseIntHandler(TIMER2, TIMA); }
+void Timer2BIntHandler(void) { pulseIntHandler(TIMER2, TIMB); }
+void Timer3AIntHandler(void) { pulseIntHandler(TIMER3, TIMA); }
+void Timer3BIntHandler(void) { pulseIntHandler(TIMER3, TIMB); }
+#ifdef TARGET_IS_BLIZZARD_RB1
+void WideTimer0AIntHandler(void) { pulseIntHandler(WTIMER0, TIMA); }
+void WideTimer0BIntHandler(void) { pulseIntHandler(WTIMER0, TIMB); }
+void WideTimer1AIntHandler(void) { pulseIntHandler(WTIMER1, TIMA); }
+void WideTimer1BIntHandler(void) { pulseIntHandler(WTIMER1, TIMB); }
+void WideTimer2AIntHandler(void) { pulseIntHandler(WTIMER2, TIMA); }
+void WideTimer2BIntHandler(void) { pulseIntHandler(WTIMER2, TIMB); }
+void WideTimer3AIntHandler(void) { pulseIntHandler(WTIMER3, TIMA); }
+void WideTimer3BIntHandler(void) { pulseIntHandler(WTIMER3, TIMB); }
+void WideTimer5AIntHandler(void) { pulseIntHandler(WTIMER5, TIMA); }
+void WideTimer5BIntHandler(void) { pulseIntHandler(WTIMER5, TIMB); }
+#endif
+
+bool pulseMeasureBegin(uint8_t pin)
+{
+    uint8_t port = digitalPinToPort(pin);
+    uint8_t timer = digitalPinToTimer(pin);
+    uint32_t portBase, offset, base, mask;
+    uint8_t ab, bit;
+    PulseChannel *ch;
+    int i;
+
+    if (port == NOT_A_PORT || timer == NOT_ON_TIMER)
+        return false;
+    offset = timerToOffset(timer);
+    if (!pulseTimerUsable(offset))
+        return false;
+    if (pulseChannel(pin))
+        return true;
+
+    // Another pin may be on the same timer half
+    ab = timerToAB(timer);
+    for (i = 0; i < PULSE_CHANNELS; i++)
+        if (pulseChannels[i].pin != NOT_A_PIN &&
+            pulseChannels[i].offset == offset && pulseChannels[i].ab == ab)
+            return false;
+    ch = pulseChannel(NOT_A_PIN);
+    if (!ch)
+        return false;
+
+    bit = digitalPinToBitMask(pin);
+    portBase = (uint32_t) portBASERegister(port);
+    base = getTimerBase(offset);
+    mask = pulseTimerMask(offset);
+
+    enableTimerPeriph(offset);
+    if (!pulseTimerHalfFree(base, ab))
+        return false;
+
+    ch->offset = offset;
+    ch->ab = ab;
+    ch->base = base;
+    ch->mask = mask;
+    ch->level = digitalPinToDataAlias(pin);
+    ch->flags = 0;
+
+    // Only this half: the other may be running analogWrite()
+    HWREG(base + TIMER_O_CTL) &= ~(TIMER_CTL_TAEN << ab);
+    HWREG(base + TIMER_O_CFG) = 0x04;
+    HWREG(base + (ab ? TIMER_O_TBMR : TIMER_O_TAMR)) =
+        TIMER_TAMR_TACMR | TIMER_TAMR_TAMR_CAP;
+    HWREG(base + (ab ? TIMER_O_TBILR : TIMER_O_TAILR)) = mask == 0xFFFFFFFF ? mask : 0xFFFF;
+    HWREG(base + (ab ? TIMER_O_TBPR : TIMER_O_TAPR)) = mask == 0xFFFFFFFF ? 0 : 0xFF;
+    HWREG(base + TIMER_O_CTL) =
+        (HWREG(base + TIMER_O_CTL) & ~(TIMER_CTL_TAEVENT_M << ab)) |
+        (TIMER_CTL_TAEVENT_BOTH << ab);
+    HWREG(base + TIMER_O_ICR) = TIMER_ICR_CAECINT << ab;
+    HWREG(base + TIMER_O_IMR) |= TIMER_IMR_CAEIM << ab;
+
+    // The pin keeps its pull-up or pull-down, only the timer drives it now
+    ROM_GPIOPinConfigure(timerToPinConfig(timer));
+    ROM_GPIODirModeSet(portBase, bit, GPIO_DIR_MODE_HW);
+
+    ch->pin = pin;
+    ROM_IntEnable(pulseTimerInt(offset, ab));
+    HWREG(base + TIMER_O_CTL) |= TIMER_CTL_TAEN << ab;
+    return true;
+}
+
+void pulseMeasureEnd(uint8_t pin)
+{
+    PulseChannel *ch = pin == NOT_A_PIN ? NULL : pulseChannel(pin);
+
+    if (!ch)
+        return;
+
+    ROM_IntDisable(pulseTimerInt(ch->offset, ch->ab));
+    HWREG(ch->base + TIMER_O_IMR) &= ~(TIMER_IMR_CAEIM << ch->ab);
+    HWREG(ch->base + TIMER_O_CTL) &= ~(TIMER_CTL_TAEN << ch->ab);
+    HWREG(ch->base + TIMER_O_ICR) = TIMER_ICR_CAECINT << ch->ab;
+    ROM_GPIODirModeSet((uint32_t) portBASERegister(digitalPinToPort(pin)),
+                       digitalPinToBitMask(pin), GPIO_DIR_MODE_IN);
+    ch->pin = NOT_A_PIN;
+}
+
+bool pulseMeasureRead(uint8_t pin, uint32_t *high, uint32_t *low)
+{
+    PulseChannel *ch = pin == NOT_A_PIN ? NULL : pulseChannel(pin);
+    bool wasDisabled, complete;
+
+    if (!ch)
+        return false;
+
+    wasDisabled = ROM_IntMasterDisable();
+    complete = (ch->flags & (PULSE_HIGH | PULSE_LOW)) == (PULSE_HIGH | PULSE_LOW);
+    if (complete) {
+        *high = ch->high;
+        *low = ch->low;
+        ch->flags &= ~(PULSE_HIGH | PULSE_LOW);
+    }
+    if (!wasDisabled)
+        ROM_IntMasterEnable();
+    return complete;
+}
+
+/*
+ * Waits for one whole pulse of state on a timer pin, the edges are the
+ * ones the timer captured
+ */
+static unsigned long pulseInCapture(uint8_t pin, uint8_t state, unsigned long timeout)
+{
+    PulseChannel *ch = pulseChannel(pin);
+    uint8_t done = state ? PULSE_HIGH : PULSE_LOW;
+    unsigned long start = micros();
+    uint32_t width = 0;
+
+    while (!(ch->flags & done)) {
+        if (micros() - start >= timeout) {
+            pulseMeasureEnd(pin);
+            return 0;
+        }
+    }
+    width = state ? ch->high : ch->low;
+    pulseMeasureEnd(pin);
+    return width / (F_CPU / 1000000);
+}
 
 /* Measures the length (in microseconds) of a pulse on the pin; state is HIGH
  * or LOW, the type of pulse to measure.  Works on pulses from 2-3 microseconds
@@ -39,6 +318,10 @@
  * before the start of the pulse. */
 unsigned long pulseIn(uint8_t pin, uint8_t state, unsigned long timeout)
 {
+    // exact to the cycle on a timer pin, unless another pin has its timer
+    if (!pulseChannel(pin) && pulseMeasureBegin(pin))
+        return pulseInCapture(pin, state, timeout);
+
     // cache the port and bit of the pin in order to speed up the
     // pulse width measuring loop and achieve finer resolution.  calling
     // digitalRead() instead yields much coarser resolution.
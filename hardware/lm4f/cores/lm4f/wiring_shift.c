@@ -31,6 +31,10 @@
  */
 
 #include "wiring_private.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_ssi.h"
+#include "driverlib/ssi.h"
+#include "driverlib/sysctl.h"
 
 uint8_t shiftIn(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder) {
     uint8_t value = 0;
@@ -61,3 +65,177 @@ void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t val)
         digitalWrite(clockPin, LOW);
     }
 }
+
+/*
+ * shiftOutBuffer() runs the SSI at this bit rate when the pins are an SSI
+ * clock and transmit pair
+ */
+#ifndef SHIFT_SSI_CLOCK
+#define SHIFT_SSI_CLOCK 4000000
+#endif
+
+typedef struct {
+    uint32_t periph;
+    uint32_t base;
+    uint32_t clockPort;
+    uint8_t clockBit;
+    uint32_t clockConfig;
+    uint32_t dataPort;
+    uint8_t dataBit;
+    uint32_t dataConfig;
+} ShiftSSI;
+
+// The same modules and pins as the SPI library, transmit is XDAT0 on TM4C129
+static const ShiftSSI shiftSSI[] = {
+#ifdef TARGET_IS_BLIZZARD_RB1
+    {SYSCTL_PERIPH_SSI0, SSI0_BASE, GPIO_PORTA_BASE, GPIO_PIN_2, GPIO_PA2_SSI0CLK,
+        GPIO_PORTA_BASE, GPIO_PIN_5, GPIO_PA5_SSI0TX},
+    {SYSCTL_PERIPH_SSI1, SSI1_BASE, GPIO_PORTF_BASE, GPIO_PIN_2, GPIO_PF2_SSI1CLK,
+        GPIO_PORTF_BASE, GPIO_PIN_1, GPIO_PF1_SSI1TX},
+    {SYSCTL_PERIPH_SSI2, SSI2_BASE, GPIO_PORTB_BASE, GPIO_PIN_4, GPIO_PB4_SSI2CLK,
+        GPIO_PORTB_BASE, GPIO_PIN_7, GPIO_PB7_SSI2TX},
+    {SYSCTL_PERIPH_SSI3, SSI3_BASE, GPIO_PORTD_BASE, GPIO_PIN_0, GPIO_PD0_SSI3CLK,
+        GPIO_PORTD_BASE, GPIO_PIN_3, GPIO_PD3_SSI3TX},
+#else
+    {SYSCTL_PERIPH_SSI0, SSI0_BASE, GPIO_PORTA_BASE, GPIO_PIN_2, GPIO_PA2_SSI0CLK,
+        GPIO_PORTA_BASE, GPIO_PIN_4, GPIO_PA4_SSI0XDAT0},
+    {SYSCTL_PERIPH_SSI1, SSI1_BASE, GPIO_PORTB_BASE, GPIO_PIN_5, GPIO_PB5_SSI1CLK,
+        GPIO_PORTE_BASE, GPIO_PIN_4, GPIO_PE4_SSI1XDAT0},
+    {SYSCTL_PERIPH_SSI2, SSI2_BASE, GPIO_PORTD_BASE, GPIO_PIN_3, GPIO_PD3_SSI2CLK,
+        GPIO_PORTD_BASE, GPIO_PIN_1, GPIO_PD1_SSI2XDAT0},
+    {SYSCTL_PERIPH_SSI3, SSI3_BASE, GPIO_PORTF_BASE, GPIO_PIN_3, GPIO_PF3_SSI3CLK,
+        GPIO_PORTF_BASE, GPIO_PIN_1, GPIO_PF1_SSI3XDAT0},
+#ifdef __TM4C129XNCZAD__
+    {SYSCTL_PERIPH_SSI2, SSI2_BASE, GPIO_PORTG_BASE, GPIO_PIN_7, GPIO_PG7_SSI2CLK,
+        GPIO_PORTG_BASE, GPIO_PIN_5, GPIO_PG5_SSI2XDAT0},
+#endif
+    {SYSCTL_PERIPH_SSI3, SSI3_BASE, GPIO_PORTQ_BASE, GPIO_PIN_0, GPIO_PQ0_SSI3CLK,
+        GPIO_PORTQ_BASE, GPIO_PIN_2, GPIO_PQ2_SSI3XDAT0},
+#endif
+};
+
+static uint8_t reverseByte(uint8_t val)
+{
+    uint32_t r = val;
+
+    asm("rbit %0, %1" : "=r" (r) : "r" (r));
+    return r >> 24;
+}
+
+/*
+ * Sends the buffer on the SSI whose clock and transmit pins these are, in
+ * SPI mode 0 like shiftOut(). Returns false, to bit-bang instead, if they
+ * are not such a pair or the SPI library has that SSI running.
+ */
+static bool shiftOutSSI(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder,
+                        const uint8_t *buf, size_t len)
+{
+    uint32_t clockPort, dataPort, rx;
+    uint8_t clockBit, dataBit;
+    const ShiftSSI *ssi = NULL;
+    size_t i;
+
+    if (digitalPinToPort(dataPin) == NOT_A_PORT ||
+        digitalPinToPort(clockPin) == NOT_A_PORT)
+        return false;
+    clockPort = (uint32_t) portBASERegister(digitalPinToPort(clockPin));
+    clockBit = digitalPinToBitMask(clockPin);
+    dataPort = (uint32_t) portBASERegister(digitalPinToPort(dataPin));
+    dataBit = digitalPinToBitMask(dataPin);
+
+    for (i = 0; i < sizeof(shiftSSI) / sizeof(shiftSSI[0]); i++) {
+        if (shiftSSI[i].clockPort == clockPort && shiftSSI[i].clockBit == clockBit &&
+            shiftSSI[i].dataPort == dataPort && shiftSSI[i].dataBit == dataBit) {
+            ssi = &shiftSSI[i];
+            break;
+        }
+    }
+    if (!ssi)
+        return false;
+
+    if (ROM_SysCtlPeripheralReady(ssi->periph) &&
+        (HWREG(ssi->base + SSI_O_CR1) & SSI_CR1_SSE))
+        return false;
+
+    ROM_SysCtlPeripheralEnable(ssi->periph);
+    while (!ROM_SysCtlPeripheralReady(ssi->periph))
+        ;
+    ROM_SSIDisable(ssi->base);
+    ROM_SSIClockSourceSet(ssi->base, SSI_CLOCK_SYSTEM);
+#ifdef TARGET_IS_BLIZZARD_RB1
+    ROM_SSIConfigSetExpClk(ssi->base, ROM_SysCtlClockGet(), SSI_FRF_MOTO_MODE_0,
+                           SSI_MODE_MASTER, SHIFT_SSI_CLOCK, 8);
+#else
+    ROM_SSIConfigSetExpClk(ssi->base, F_CPU, SSI_FRF_MOTO_MODE_0,
+                           SSI_MODE_MASTER, SHIFT_SSI_CLOCK, 8);
+#endif
+    ROM_GPIOPinConfigure(ssi->clockConfig);
+    ROM_GPIOPinConfigure(ssi->dataConfig);
+    ROM_GPIOPinTypeSSI(clockPort, clockBit);
+    ROM_GPIOPinTypeSSI(dataPort, dataBit);
+    ROM_SSIEnable(ssi->base);
+
+    // SSIDataPut() waits for room, so the FIFO keeps the line busy
+    for (i = 0; i < len; i++)
+        ROM_SSIDataPut(ssi->base, bitOrder == LSBFIRST ? reverseByte(buf[i]) : buf[i]);
+    while (ROM_SSIBusy(ssi->base))
+        ;
+
+    // Nothing is wired to receive, drop what came in and hand the pins back
+    while (ROM_SSIDataGetNonBlocking(ssi->base, &rx))
+        ;
+    ROM_SSIDisable(ssi->base);
+    pinMode(clockPin, OUTPUT);
+    pinMode(dataPin, OUTPUT);
+    return true;
+}
+
+void shiftOutBuffer(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder,
+                    const uint8_t *buf, size_t len)
+{
+    volatile uint32_t *data, *clock;
+    uint8_t val, i;
+
+    if (shiftOutSSI(dataPin, clockPin, bitOrder, buf, len))
+        return;
+
+    data = digitalPinToDataAlias(dataPin);
+    clock = digitalPinToDataAlias(clockPin);
+    if (!data || !clock)
+        return;
+
+    while (len--) {
+        val = *buf++;
+        if (bitOrder == LSBFIRST)
+            val = reverseByte(val);
+        for (i = 0; i < 8; i++) {
+            *data = (val & 0x80) ? 0xFF : 0;
+            *clock = 0xFF;
+            *clock = 0;
+            val <<= 1;
+        }
+    }
+}
+
+void shiftInBuffer(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder,
+                   uint8_t *buf, size_t len)
+{
+    volatile uint32_t *data, *clock;
+    uint8_t val, i;
+
+    data = digitalPinToDataAlias(dataPin);
+    clock = digitalPinToDataAlias(clockPin);
+    if (!data || !clock)
+        return;
+
+    // Read after the rising edge like shiftIn(), which an SSI cannot do
+    while (len--) {
+        val = 0;
+        for (i = 0; i < 8; i++) {
+            *clock = 0xFF;
+            val = (val << 1) | (*data ? 1 : 0);
+            *clock = 0;
+        }
+        *buf++ = bitOrder == LSBFIRST ? reverseByte(val) : val;
+    }
+}
@@ -1,17 +1,27 @@
 #include <Energia.h>
+#include <wheeltimer.h>
 #include <Ethernet.h>
 #include <inc/hw_ints.h>
 #include <lwip/inet.h>
 #include <IPAddress.h>
 
 #define ETHERNET_INT_PRIORITY   0xC0
+#define ETHERNET_TIMER_MS       10
+
+static WheelTimer lwIPTick;
+
+static void lwIPTickRun(void *arg)
+{
+	lwIPTimer(ETHERNET_TIMER_MS);
+}
 
 void EthernetClass::begin(uint8_t *mac_address, IPAddress local_ip, IPAddress dns_server, IPAddress gateway, IPAddress subnet)
 {
 	uint32_t ui32User0, ui32User1;
 	uint8_t pui8MACArray[8];
 
-	registerSysTickCb(lwIPTimer);
+	wheelTimerInit(&lwIPTick, lwIPTickRun, NULL, 0);
+	wheelTimerStart(&lwIPTick, ETHERNET_TIMER_MS, ETHERNET_TIMER_MS);
 	ROM_FlashUserGet(&ui32User0, &ui32User1);
 
 	/*
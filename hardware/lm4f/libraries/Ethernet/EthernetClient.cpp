@@ -6,12 +6,14 @@
 
 EthernetClient::EthernetClient(){
 	_connected = false;
+	_connecting = CONNECTING_NONE;
 	cs = &client_state;
 	_read = &cs->read;
 	cs->mode = true;
 }
 
 EthernetClient::EthernetClient(struct client *c) {
+	_connecting = CONNECTING_NONE;
 	if(c == NULL) {
 		cpcb = NULL;
 		return;
@@ -113,25 +115,54 @@ void EthernetClient::do_dns(const char *name, struct ip_addr *ipaddr, void *arg)
 
 int EthernetClient::connect(const char* host, uint16_t port)
 {
-	ip_addr_t ip;
-	ip.addr = 0;
+	int ret;
 
-	dns_gethostbyname(host, &ip, do_dns, &ip);
+	if(!beginConnect(host, port)) return false;
 
-	while(!ip.addr) {
+	while((ret = connectPoll()) == CONNECT_PENDING) {
 		delay(10);
 	}
 
-	if(ip.addr == IPADDR_NONE) return false;
-
-	return(connect(IPAddress(ip.addr), port));
+	return ret;
 }
 
 int EthernetClient::connect(IPAddress ip, uint16_t port)
+{
+	int ret;
+
+	if(!beginConnect(ip, port)) return false;
+
+	while((ret = connectPoll()) == CONNECT_PENDING) {
+		delay(10);
+	}
+
+	return ret;
+}
+
+int EthernetClient::beginConnect(const char* host, uint16_t port)
+{
+	_connecting = CONNECTING_NONE;
+	_host.addr = 0;
+	_hostPort = port;
+
+	/* do_dns() fills in _host later unless the name was cached */
+	err_t err = dns_gethostbyname(host, &_host, do_dns, &_host);
+
+	if(err != ERR_OK && err != ERR_INPROGRESS) {
+		return false;
+	}
+
+	_connecting = CONNECTING_DNS;
+	return true;
+}
+
+int EthernetClient::beginConnect(IPAddress ip, uint16_t port)
 {
 	ip_addr_t dest;
 	dest.addr = ip;
 
+	_connecting = CONNECTING_NONE;
+
 	cpcb = tcp_new();
 
 	if(cpcb == NULL) {
@@ -148,28 +179,49 @@ int EthernetClient::connect(IPAddress ip, uint16_t port)
 		return false;
 	}
 
+	_connectStart = millis();
+	_connecting = CONNECTING_TCP;
+	return true;
+}
 
-	/* Wait for the connection.
-	 * Abort if the connection does not succeed within 10 sec */
-	unsigned long then = millis();
+int EthernetClient::connectPoll()
+{
+	switch(_connecting) {
+	case CONNECTING_DNS:
+		if(!_host.addr) return CONNECT_PENDING;
 
-	while(!_connected) {
-		unsigned long now = millis();
-		delay(10);
-		if(now - then > CONNECTION_TIMEOUT) {
-			tcp_close(cpcb);
-			cpcb = NULL;
+		if(_host.addr == IPADDR_NONE ||
+		   !beginConnect(IPAddress(_host.addr), _hostPort)) {
+			_connecting = CONNECTING_NONE;
 			return false;
 		}
-	}
+		return CONNECT_PENDING;
+
+	case CONNECTING_TCP:
+		/* Abort if the connection does not succeed within 10 sec */
+		if(!_connected) {
+			if(millis() - _connectStart > CONNECTION_TIMEOUT) {
+				tcp_close(cpcb);
+				cpcb = NULL;
+				_connecting = CONNECTING_NONE;
+				return false;
+			}
+			return CONNECT_PENDING;
+		}
 
-	if(cpcb->state != ESTABLISHED) {
-		_connected = false;
-	}
+		_connecting = CONNECTING_NONE;
 
-	/* Poll to determine if the peer is still alive */
-	tcp_poll(cpcb, do_poll, 10);
-	return _connected;
+		if(cpcb->state != ESTABLISHED) {
+			_connected = false;
+		}
+
+		/* Poll to determine if the peer is still alive */
+		tcp_poll(cpcb, do_poll, 10);
+		return _connected;
+
+	default:
+		return _connected;
+	}
 }
 
 size_t EthernetClient::write(uint8_t b) {
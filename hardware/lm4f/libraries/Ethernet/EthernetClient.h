@@ -10,6 +10,9 @@
 /* Set connection timeout to 10 sec */
 #define CONNECTION_TIMEOUT 1000 * 10
 
+/* connectPoll() result while still looking up or connecting */
+#define CONNECT_PENDING -1
+
 class EthernetClient : public Client {
 public:
 	EthernetClient();
@@ -18,6 +21,12 @@ public:
 	uint8_t status();
 	virtual int connect(IPAddress ip, uint16_t port);
 	virtual int connect(const char *host, uint16_t port);
+	/* Connect without waiting: after beginConnect() call connectPoll(),
+	 * e.g. from a task, until it no longer returns CONNECT_PENDING.
+	 * It then returns what connect() would have */
+	int beginConnect(IPAddress ip, uint16_t port);
+	int beginConnect(const char *host, uint16_t port);
+	int connectPoll();
 	virtual size_t write(uint8_t);
 	virtual size_t write(const uint8_t *buf, size_t size);
 	virtual int available();
@@ -44,5 +53,9 @@ private:
 	uint16_t *_read;
 	volatile bool _connected;
 	struct client *cs;
+	enum { CONNECTING_NONE, CONNECTING_DNS, CONNECTING_TCP } _connecting;
+	ip_addr_t _host;
+	uint16_t _hostPort;
+	unsigned long _connectStart;
 };
 #endif
@@ -915,10 +915,12 @@ lwIPEthernetIntHandler(void)
     // No RTOS is being used.  If a transmit/receive interrupt was active,
     // run the low-level interrupt handler.
     //
+    PROFILE_DRIVER_BEGIN(lwipInput, "lwip.input");
     if(ui32Status)
     {
         tivaif_interrupt(&g_sNetIF, ui32Status);
     }
+    PROFILE_DRIVER_END(lwipInput);
 
     //
     // Service the lwIP timers.
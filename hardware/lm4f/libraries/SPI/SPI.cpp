@@ -247,6 +247,8 @@ void SPIClass::setClockDivider(uint8_t divider){
 }
 
 uint8_t SPIClass::transfer(uint8_t data) {
+	PROFILE_DRIVER_SCOPE("spi.transfer");
+
 	unsigned long rxtxData;
 
 	rxtxData = data;
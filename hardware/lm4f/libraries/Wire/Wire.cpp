@@ -391,6 +391,8 @@ void TwoWire::begin(int address)
 
 uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop)
 {
+  PROFILE_DRIVER_SCOPE("wire.requestFrom");
+
   uint8_t error = 0;
   uint8_t oldWriteIndex = rxWriteIndex;
   uint8_t spaceAvailable = (rxWriteIndex >= rxReadIndex) ?
@@ -467,6 +469,8 @@ void TwoWire::beginTransmission(int address)
 
 uint8_t TwoWire::endTransmission(uint8_t sendStop)
 {
+  PROFILE_DRIVER_SCOPE("wire.endTransmission");
+
   uint8_t error = I2C_MASTER_ERR_NONE;
 
   if(TX_BUFFER_EMPTY) return 0;
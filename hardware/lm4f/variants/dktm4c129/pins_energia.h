@@ -196,28 +196,199 @@ static const uint8_t A21 = 79; //PE_7
 static const uint8_t A22 = 80; //PP_7
 static const uint8_t A23 = 52; //PP_6
 
+/*
+ * The tables as lists, so that inline code (digitalWriteFast) can look
+ * constant pins up at compile time
+ */
+#define PORT_TO_BASE_TABLE \
+    NOT_A_PORT,                          \
+    (uint32_t) GPIO_PORTA_BASE, /* 1 */  \
+    (uint32_t) GPIO_PORTB_BASE, /* 2 */  \
+    (uint32_t) GPIO_PORTC_BASE, /* 3 */  \
+    (uint32_t) GPIO_PORTD_BASE, /* 4 */  \
+    (uint32_t) GPIO_PORTE_BASE, /* 5 */  \
+    (uint32_t) GPIO_PORTF_BASE, /* 6 */  \
+    (uint32_t) GPIO_PORTG_BASE, /* 7 */  \
+    (uint32_t) GPIO_PORTH_BASE, /* 8 */  \
+    (uint32_t) GPIO_PORTJ_BASE, /* 9 */  \
+    (uint32_t) GPIO_PORTK_BASE, /* 10 */ \
+    (uint32_t) GPIO_PORTL_BASE, /* 11 */ \
+    (uint32_t) GPIO_PORTM_BASE, /* 12 */ \
+    (uint32_t) GPIO_PORTN_BASE, /* 13 */ \
+    (uint32_t) GPIO_PORTP_BASE, /* 14 */ \
+    (uint32_t) GPIO_PORTQ_BASE, /* 15 */ \
+    (uint32_t) GPIO_PORTR_BASE, /* 16 */ \
+    (uint32_t) GPIO_PORTS_BASE, /* 17 */ \
+    (uint32_t) GPIO_PORTT_BASE, /* 18 */
+
+#define DIGITAL_PIN_TO_PORT_TABLE \
+    NOT_A_PIN,  /*   dummy */           \
+    NOT_A_PIN,  /*   1 - 3.3V */        \
+    PE,         /*   2 - PE_2 */        \
+    PH,         /*   3 - PH_6 */        \
+    PH,         /*   4 - PH_7 */        \
+    PN,         /*   5 - PN_7 */        \
+    PF,         /*   6 - PF_3 */        \
+    PG,         /*   7 - PG_7 */        \
+    PJ,         /*   8 - PJ_2 */        \
+    PB,         /*   9 - PB_4 */        \
+    PJ,         /*  10 - PJ_7 */        \
+    PN,         /*  11 - PN_2 */        \
+    PN,         /*  12 - PN_1 */        \
+    PN,         /*  13 - PN_0 */        \
+    PG,         /*  14 - PG_4 */        \
+    PG,         /*  15 - PG_5 */        \
+    NOT_A_PIN,  /*  16 - RST */         \
+    NOT_A_PIN,  /*  17 - NC */          \
+    PQ,         /*  18 - PQ_7 */        \
+    PS,         /*  19 - PS_2 */        \
+    NOT_A_PIN,  /*  20 - GND */         \
+    NOT_A_PIN,  /*  21 - VBUS */        \
+    NOT_A_PIN,  /*  22 - GND */         \
+    PE,         /*  23 - PE_3 */        \
+    PE,         /*  24 - PE_6 */        \
+    PK,         /*  25 - PK_0 */        \
+    PK,         /*  26 - PK_1 */        \
+    PK,         /*  27 - PK_2 */        \
+    PK,         /*  28 - PK_3 */        \
+    PE,         /*  29 - PE_0 */        \
+    PE,         /*  30 - PE_1 */        \
+    PM,         /*  31 - PM_7 */        \
+    PD,         /*  32 - PD_2 */        \
+    PQ,         /*  33 - PQ_3 */        \
+    PS,         /*  34 - PS_1 */        \
+    PS,         /*  35 - PS_0 */        \
+    PL,         /*  36 - PL_4 */        \
+    PL,         /*  37 - PL_5 */        \
+    PS,         /*  38 - PS_3 */        \
+    PD,         /*  39 - PD_3 */        \
+    PM,         /*  40 - PM_5 */        \
+    NOT_A_PIN,  /*  41 - J6_VCC */      \
+    PD,         /*  42 - PD_0 */        \
+    PJ,         /*  43 - PJ_0 BP2_RX */ \
+    PJ,         /*  44 - PJ_1 BP2_TX */ \
+    PT,         /*  45 - PT_0 */        \
+    PT,         /*  46 - PT_1 */        \
+    PA,         /*  47 - PA_2 */        \
+    PS,         /*  48 - PS_6 */        \
+    PS,         /*  49 - PS_7 */        \
+    PB,         /*  50 - PB_5 */        \
+    PD,         /*  51 - PD_5 */        \
+    PP,         /*  52 - PP_6 */        \
+    PH,         /*  53 - PH_5 */        \
+    PA,         /*  54 - PA_5 */        \
+    PA,         /*  55 - PA_4 */        \
+    NOT_A_PIN,  /*  56 - RESET */       \
+    PE,         /*  57 - PE_4 */        \
+    PJ,         /*  58 - PJ_3 */        \
+    PD,         /*  59 - PD_1 */        \
+    NOT_A_PIN,  /*  60 - GND */         \
+    PN,         /*  61 - PN_5 */        \
+    PQ,         /*  62 - PQ_4 */        \
+    PF,         /*  63 - PF_1 */        \
+    PK,         /*  64 - PK_4 */        \
+    PK,         /*  65 - PK_6 */        \
+    PN,         /*  66 - PN_3 */        \
+    PE,         /*  67 - PE_5 */        \
+    PP,         /*  68 - PP_1 */        \
+    PA,         /*  69 - PA_3 */        \
+    PB,         /*  70 - PB_6 */        \
+    PB,         /*  71 - PB_7 */        \
+    PF,         /*  72 - PF_0 */        \
+    PF,         /*  73 - PF_2 */        \
+    PQ,         /*  74 - PQ_1 */        \
+    PQ,         /*  75 - PQ_2 */        \
+    PD,         /*  76 - PD_6 */        \
+    PD,         /*  77 - PD_7 */        \
+    PD,         /*  78 - PD_4 */        \
+    PE,         /*  79 - PE_7 */        \
+    PP,         /*  80 - PP_7 */
+
+#define DIGITAL_PIN_TO_BIT_MASK_TABLE \
+    NOT_A_PIN,  /*   dummy */           \
+    NOT_A_PIN,  /*   1 - 3.3V */        \
+    BV(2),      /*   2 - PE_2 */        \
+    BV(6),      /*   3 - PH_6 */        \
+    BV(7),      /*   4 - PH_7 */        \
+    BV(7),      /*   5 - PN_7 */        \
+    BV(3),      /*   6 - PF_3 */        \
+    BV(7),      /*   7 - PG_7 */        \
+    BV(2),      /*   8 - PJ_2 */        \
+    BV(4),      /*   9 - PB_4 */        \
+    BV(7),      /*  10 - PJ_7 */        \
+    BV(2),      /*  11 - PN_2 */        \
+    BV(1),      /*  12 - PN_1 */        \
+    BV(0),      /*  13 - PN_0 */        \
+    BV(4),      /*  14 - PG_4 */        \
+    BV(5),      /*  15 - PG_5 */        \
+    NOT_A_PIN,  /*  16 - RST */         \
+    NOT_A_PIN,  /*  17 - NC */          \
+    BV(7),      /*  18 - PQ_7 */        \
+    BV(2),      /*  19 - PS_2 */        \
+    NOT_A_PIN,  /*  20 - GND */         \
+    NOT_A_PIN,  /*  21 - VBUS */        \
+    NOT_A_PIN,  /*  22 - GND */         \
+    BV(3),      /*  23 - PE_3 */        \
+    BV(6),      /*  24 - PE_6 */        \
+    BV(0),      /*  25 - PK_0 */        \
+    BV(1),      /*  26 - PK_1 */        \
+    BV(2),      /*  27 - PK_2 */        \
+    BV(3),      /*  28 - PK_3 */        \
+    BV(0),      /*  29 - PE_0 */        \
+    BV(1),      /*  30 - PE_1 */        \
+    BV(7),      /*  31 - PM_7 */        \
+    BV(2),      /*  32 - PD_2 */        \
+    BV(3),      /*  33 - PQ_3 */        \
+    BV(1),      /*  34 - PS_1 */        \
+    BV(0),      /*  35 - PS_0 */        \
+    BV(4),      /*  36 - PL_4 */        \
+    BV(5),      /*  37 - PL_5 */        \
+    BV(3),      /*  38 - PS_3 */        \
+    BV(3),      /*  39 - PD_3 */        \
+    BV(5),      /*  40 - PM_5 */        \
+    NOT_A_PIN,  /*  41 - J6_VCC */      \
+    BV(0),      /*  42 - PD_0 */        \
+    BV(0),      /*  43 - PJ_0 BP2_RX */ \
+    BV(1),      /*  44 - PJ_1 BP2_TX */ \
+    BV(0),      /*  45 - PT_0 */        \
+    BV(1),      /*  46 - PT_1 */        \
+    BV(2),      /*  47 - PA_2 */        \
+    BV(6),      /*  48 - PS_6 */        \
+    BV(7),      /*  49 - PS_7 */        \
+    BV(5),      /*  50 - PB_5 */        \
+    BV(5),      /*  51 - PD_5 */        \
+    BV(6),      /*  52 - PP_6 */        \
+    BV(5),      /*  53 - PH_5 */        \
+    BV(5),      /*  54 - PA_5 */        \
+    BV(4),      /*  55 - PA_4 */        \
+    NOT_A_PIN,  /*  56 - RESET */       \
+    BV(4),      /*  57 - PE_4 */        \
+    BV(3),      /*  58 - PJ_3 */        \
+    BV(1),      /*  59 - PD_1 */        \
+    NOT_A_PIN,  /*  60 - GND */         \
+    BV(5),      /*  61 - PN_5 */        \
+    BV(4),      /*  62 - PQ_4 */        \
+    BV(1),      /*  63 - PF_1 */        \
+    BV(4),      /*  64 - PK_4 */        \
+    BV(6),      /*  65 - PK_6 */        \
+    BV(3),      /*  66 - PN_3 */        \
+    BV(5),      /*  67 - PE_5 */        \
+    BV(1),      /*  68 - PP_1 */        \
+    BV(2),      /*  69 - PA_3 */        \
+    BV(6),      /*  70 - PB_6 */        \
+    BV(7),      /*  71 - PB_7 */        \
+    BV(0),      /*  72 - PF_0 */        \
+    BV(2),      /*  73 - PF_2 */        \
+    BV(1),      /*  74 - PQ_1 */        \
+    BV(2),      /*  75 - PQ_2 */        \
+    BV(6),      /*  76 - PD_6 */        \
+    BV(7),      /*  77 - PD_7 */        \
+    BV(4),      /*  78 - PD_4 */        \
+    BV(7),      /*  79 - PE_7 */        \
+    BV(7),      /*  80 - PP_7 */
+
 #ifdef ARDUINO_MAIN
-const uint32_t port_to_base[] = {
-    NOT_A_PORT,
-    (uint32_t) GPIO_PORTA_BASE, // 1
-    (uint32_t) GPIO_PORTB_BASE, // 2
-    (uint32_t) GPIO_PORTC_BASE, // 3
-    (uint32_t) GPIO_PORTD_BASE, // 4
-    (uint32_t) GPIO_PORTE_BASE, // 5
-    (uint32_t) GPIO_PORTF_BASE, // 6
-    (uint32_t) GPIO_PORTG_BASE, // 7
-    (uint32_t) GPIO_PORTH_BASE, // 8
-    (uint32_t) GPIO_PORTJ_BASE, // 9
-    (uint32_t) GPIO_PORTK_BASE, // 10
-    (uint32_t) GPIO_PORTL_BASE, // 11
-    (uint32_t) GPIO_PORTM_BASE, // 12
-    (uint32_t) GPIO_PORTN_BASE, // 13
-    (uint32_t) GPIO_PORTP_BASE, // 14
-    (uint32_t) GPIO_PORTQ_BASE, // 15
-    (uint32_t) GPIO_PORTR_BASE, // 16
-    (uint32_t) GPIO_PORTS_BASE, // 17
-    (uint32_t) GPIO_PORTT_BASE, // 18
-};
+const uint32_t port_to_base[] = { PORT_TO_BASE_TABLE };
 const uint8_t digital_pin_to_timer[] = {
     NOT_ON_TIMER,   /*  dummy */
     NOT_ON_TIMER,   /*   1 - 3.3V */
@@ -302,172 +473,8 @@ const uint8_t digital_pin_to_timer[] = {
     NOT_ON_TIMER,   /*  80 - PP_7 */
 };
 
-const uint8_t digital_pin_to_port[] = {
-    NOT_A_PIN,  /*   dummy */
-    NOT_A_PIN,  /*   1 - 3.3V */
-    PE,         /*   2 - PE_2 */
-    PH,         /*   3 - PH_6 */
-    PH,         /*   4 - PH_7 */
-    PN,         /*   5 - PN_7 */
-    PF,         /*   6 - PF_3 */
-    PG,         /*   7 - PG_7 */
-    PJ,         /*   8 - PJ_2 */
-    PB,         /*   9 - PB_4 */
-    PJ,         /*  10 - PJ_7 */
-    PN,         /*  11 - PN_2 */
-    PN,         /*  12 - PN_1 */
-    PN,         /*  13 - PN_0 */
-    PG,         /*  14 - PG_4 */
-    PG,         /*  15 - PG_5 */
-    NOT_A_PIN,  /*  16 - RST */
-    NOT_A_PIN,  /*  17 - NC */
-    PQ,         /*  18 - PQ_7 */
-    PS,         /*  19 - PS_2 */
-    NOT_A_PIN,  /*  20 - GND */
-    NOT_A_PIN,  /*  21 - VBUS */
-    NOT_A_PIN,  /*  22 - GND */
-    PE,         /*  23 - PE_3 */
-    PE,         /*  24 - PE_6 */
-    PK,         /*  25 - PK_0 */
-    PK,         /*  26 - PK_1 */
-    PK,         /*  27 - PK_2 */
-    PK,         /*  28 - PK_3 */
-    PE,         /*  29 - PE_0 */
-    PE,         /*  30 - PE_1 */
-    PM,         /*  31 - PM_7 */
-    PD,         /*  32 - PD_2 */
-    PQ,         /*  33 - PQ_3 */
-    PS,         /*  34 - PS_1 */
-    PS,         /*  35 - PS_0 */
-    PL,         /*  36 - PL_4 */
-    PL,         /*  37 - PL_5 */
-    PS,         /*  38 - PS_3 */
-    PD,         /*  39 - PD_3 */
-    PM,         /*  40 - PM_5 */
-    NOT_A_PIN,  /*  41 - J6_VCC */
-    PD,         /*  42 - PD_0 */
-    PJ,         /*  43 - PJ_0 BP2_RX */
-    PJ,         /*  44 - PJ_1 BP2_TX */
-    PT,         /*  45 - PT_0 */
-    PT,         /*  46 - PT_1 */
-    PA,         /*  47 - PA_2 */
-    PS,         /*  48 - PS_6 */
-    PS,         /*  49 - PS_7 */
-    PB,         /*  50 - PB_5 */
-    PD,         /*  51 - PD_5 */
-    PP,         /*  52 - PP_6 */
-    PH,         /*  53 - PH_5 */
-    PA,         /*  54 - PA_5 */
-    PA,         /*  55 - PA_4 */
-    NOT_A_PIN,  /*  56 - RESET */
-    PE,         /*  57 - PE_4 */
-    PJ,         /*  58 - PJ_3 */
-    PD,         /*  59 - PD_1 */
-    NOT_A_PIN,  /*  60 - GND */
-    PN,         /*  61 - PN_5 */
-    PQ,         /*  62 - PQ_4 */
-    PF,         /*  63 - PF_1 */
-    PK,         /*  64 - PK_4 */
-    PK,         /*  65 - PK_6 */
-    PN,         /*  66 - PN_3 */
-    PE,         /*  67 - PE_5 */
-    PP,         /*  68 - PP_1 */
-    PA,         /*  69 - PA_3 */
-    PB,         /*  70 - PB_6 */
-    PB,         /*  71 - PB_7 */
-    PF,         /*  72 - PF_0 */
-    PF,         /*  73 - PF_2 */
-    PQ,         /*  74 - PQ_1 */
-    PQ,         /*  75 - PQ_2 */
-    PD,         /*  76 - PD_6 */
-    PD,         /*  77 - PD_7 */
-    PD,         /*  78 - PD_4 */
-    PE,         /*  79 - PE_7 */
-    PP,         /*  80 - PP_7 */
-};
-const uint8_t digital_pin_to_bit_mask[] = {
-    NOT_A_PIN,  /*   dummy */
-    NOT_A_PIN,  /*   1 - 3.3V */
-    BV(2),      /*   2 - PE_2 */
-    BV(6),      /*   3 - PH_6 */
-    BV(7),      /*   4 - PH_7 */
-    BV(7),      /*   5 - PN_7 */
-    BV(3),      /*   6 - PF_3 */
-    BV(7),      /*   7 - PG_7 */
-    BV(2),      /*   8 - PJ_2 */
-    BV(4),      /*   9 - PB_4 */
-    BV(7),      /*  10 - PJ_7 */
-    BV(2),      /*  11 - PN_2 */
-    BV(1),      /*  12 - PN_1 */
-    BV(0),      /*  13 - PN_0 */
-    BV(4),      /*  14 - PG_4 */
-    BV(5),      /*  15 - PG_5 */
-    NOT_A_PIN,  /*  16 - RST */
-    NOT_A_PIN,  /*  17 - NC */
-    BV(7),      /*  18 - PQ_7 */
-    BV(2),      /*  19 - PS_2 */
-    NOT_A_PIN,  /*  20 - GND */
-    NOT_A_PIN,  /*  21 - VBUS */
-    NOT_A_PIN,  /*  22 - GND */
-    BV(3),      /*  23 - PE_3 */
-    BV(6),      /*  24 - PE_6 */
-    BV(0),      /*  25 - PK_0 */
-    BV(1),      /*  26 - PK_1 */
-    BV(2),      /*  27 - PK_2 */
-    BV(3),      /*  28 - PK_3 */
-    BV(0),      /*  29 - PE_0 */
-    BV(1),      /*  30 - PE_1 */
-    BV(7),      /*  31 - PM_7 */
-    BV(2),      /*  32 - PD_2 */
-    BV(3),      /*  33 - PQ_3 */
-    BV(1),      /*  34 - PS_1 */
-    BV(0),      /*  35 - PS_0 */
-    BV(4),      /*  36 - PL_4 */
-    BV(5),      /*  37 - PL_5 */
-    BV(3),      /*  38 - PS_3 */
-    BV(3),      /*  39 - PD_3 */
-    BV(5),      /*  40 - PM_5 */
-    NOT_A_PIN,  /*  41 - J6_VCC */
-    BV(0),      /*  42 - PD_0 */
-    BV(0),      /*  43 - PJ_0 BP2_RX */
-    BV(1),      /*  44 - PJ_1 BP2_TX */
-    BV(0),      /*  45 - PT_0 */
-    BV(1),      /*  46 - PT_1 */
-    BV(2),      /*  47 - PA_2 */
-    BV(6),      /*  48 - PS_6 */
-    BV(7),      /*  49 - PS_7 */
-    BV(5),      /*  50 - PB_5 */
-    BV(5),      /*  51 - PD_5 */
-    BV(6),      /*  52 - PP_6 */
-    BV(5),      /*  53 - PH_5 */
-    BV(5),      /*  54 - PA_5 */
-    BV(4),      /*  55 - PA_4 */
-    NOT_A_PIN,  /*  56 - RESET */
-    BV(4),      /*  57 - PE_4 */
-    BV(3),      /*  58 - PJ_3 */
-    BV(1),      /*  59 - PD_1 */
-    NOT_A_PIN,  /*  60 - GND */
-    BV(5),      /*  61 - PN_5 */
-    BV(4),      /*  62 - PQ_4 */
-    BV(1),      /*  63 - PF_1 */
-    BV(4),      /*  64 - PK_4 */
-    BV(6),      /*  65 - PK_6 */
-    BV(3),      /*  66 - PN_3 */
-    BV(5),      /*  67 - PE_5 */
-    BV(1),      /*  68 - PP_1 */
-    BV(2),      /*  69 - PA_3 */
-    BV(6),      /*  70 - PB_6 */
-    BV(7),      /*  71 - PB_7 */
-    BV(0),      /*  72 - PF_0 */
-    BV(2),      /*  73 - PF_2 */
-    BV(1),      /*  74 - PQ_1 */
-    BV(2),      /*  75 - PQ_2 */
-    BV(6),      /*  76 - PD_6 */
-    BV(7),      /*  77 - PD_7 */
-    BV(4),      /*  78 - PD_4 */
-    BV(7),      /*  79 - PE_7 */
-    BV(7),      /*  80 - PP_7 */
-};
+const uint8_t digital_pin_to_port[] = { DIGITAL_PIN_TO_PORT_TABLE };
+const uint8_t digital_pin_to_bit_mask[] = { DIGITAL_PIN_TO_BIT_MASK_TABLE };
 
 const uint32_t timer_to_offset[] = {
     TIMER0,
@@ -0,0 +1,74 @@
+/* TestAnalogReadMulti
+  Connect A0 to 3V3 and A1 to GND. Checks analogRead() and one
+  analogReadMulti() sequence over both pins (plus a pin not on the ADC),
+  checks that a pin taken back by pinMode() still reads after it, and
+  prints the time per read, single and multi, with and without 16x
+  hardware oversampling.
+*/
+
+#define HIGH_PIN A0
+#define LOW_PIN A1
+#define READS 1000
+
+const uint8_t pins[] = { HIGH_PIN, LOW_PIN, PN_2, HIGH_PIN };
+uint16_t values[4];
+
+void timeReads(const char *what) {
+  uint32_t start;
+  int i;
+
+  start = profileCycles();
+  for (i = 0; i < READS; i++)
+    analogRead(HIGH_PIN);
+  Serial.print(what);
+  Serial.print(" analogRead cycles: ");
+  Serial.println((profileCycles() - start) / READS);
+
+  start = profileCycles();
+  for (i = 0; i < READS; i++)
+    analogReadMulti(pins, values, 4);
+  Serial.print(what);
+  Serial.print(" analogReadMulti cycles: ");
+  Serial.println((profileCycles() - start) / READS);
+}
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("\nTestAnalogReadMulti setup");
+
+  Serial.print("A0, expect 4000 to 4095: ");
+  Serial.println(analogRead(HIGH_PIN));
+  Serial.print("A1, expect 0 to 95: ");
+  Serial.println(analogRead(LOW_PIN));
+  Serial.print("A0 again, expect 4000 to 4095: ");
+  Serial.println(analogRead(HIGH_PIN));
+
+  Serial.print("converted, expect 3: ");
+  Serial.println(analogReadMulti(pins, values, 4));
+  Serial.print("multi A0, expect 4000 to 4095: ");
+  Serial.println(values[0]);
+  Serial.print("multi A1, expect 0 to 95: ");
+  Serial.println(values[1]);
+  Serial.print("multi not ADC, expect 0: ");
+  Serial.println(values[2]);
+  Serial.print("multi A0 again, expect 4000 to 4095: ");
+  Serial.println(values[3]);
+  Serial.print("none on ADC, expect 0: ");
+  Serial.println(analogReadMulti(&pins[2], values, 1));
+
+  pinMode(HIGH_PIN, INPUT);
+  Serial.print("A0 after pinMode, expect 4000 to 4095: ");
+  Serial.println(analogRead(HIGH_PIN));
+
+  timeReads("plain");
+  analogReadOversample(16);
+  Serial.print("oversampled A0, expect 4000 to 4095: ");
+  Serial.println(analogRead(HIGH_PIN));
+  Serial.print("oversampled A1, expect 0 to 95: ");
+  Serial.println(analogRead(LOW_PIN));
+  timeReads("16x");
+  analogReadOversample(0);
+}
+
+void loop() {
+}
@@ -0,0 +1,72 @@
+/* TestAnalogStream
+  Connect A0 to 3V3 and A1 to GND. Streams both pins at 10 kHz into
+  256 sample blocks for one second, polling analogStreamRead(), and
+  checks the block count and that the samples alternate high and low.
+  Then streams A0 alone at 1 MSPS with a callback for 100 ms and checks
+  the block count, with analogRead() on ADC0 still working meanwhile.
+*/
+
+#define BLOCK 256
+#define FAST_BLOCK 1024
+
+const uint8_t pins[] = { A0, A1 };
+uint16_t buffer0[FAST_BLOCK], buffer1[FAST_BLOCK];
+volatile unsigned long callbacks;
+volatile unsigned long callbackSamples;
+
+void blockDone(uint16_t *block, uint16_t samples) {
+  callbacks++;
+  callbackSamples = samples;
+}
+
+void setup() {
+  unsigned long blocks = 0, wrong = 0;
+  uint16_t *block;
+  uint32_t start;
+  int i;
+
+  Serial.begin(115200);
+  Serial.println("\nTestAnalogStream setup");
+
+  Serial.print("too fast refused, expect 0: ");
+  Serial.println(analogStreamBegin(pins, 2, 600000, buffer0, buffer1, BLOCK, 0));
+  Serial.print("odd block refused, expect 0: ");
+  Serial.println(analogStreamBegin(pins, 2, 10000, buffer0, buffer1, BLOCK - 1, 0));
+  Serial.print("begin, expect 1: ");
+  Serial.println(analogStreamBegin(pins, 2, 10000, buffer0, buffer1, BLOCK, 0));
+  start = millis();
+  while (millis() - start < 1000) {
+    block = analogStreamRead();
+    if (!block)
+      continue;
+    blocks++;
+    for (i = 0; i < BLOCK; i += 2)
+      if (block[i] < 4000 || block[i + 1] > 95)
+        wrong++;
+  }
+  analogStreamEnd();
+  Serial.print("blocks in 1 s, expect 77 to 79: ");
+  Serial.println(blocks);
+  Serial.print("samples out of place, expect 0: ");
+  Serial.println(wrong);
+  Serial.print("overruns, expect 0: ");
+  Serial.println(analogStreamOverruns());
+
+  Serial.print("fast begin, expect 1: ");
+  Serial.println(analogStreamBegin(pins, 1, 1000000, buffer0, buffer1, FAST_BLOCK, blockDone));
+  delay(100);
+  Serial.print("analogRead while streaming, expect 0 to 95: ");
+  Serial.println(analogRead(A1));
+  analogStreamEnd();
+  Serial.print("callbacks in 100 ms, expect 95 to 99: ");
+  Serial.println(callbacks);
+  Serial.print("samples per callback, expect ");
+  Serial.print(FAST_BLOCK);
+  Serial.print(": ");
+  Serial.println(callbackSamples);
+  Serial.print("fast sample, expect 4000 to 4095: ");
+  Serial.println(buffer0[FAST_BLOCK / 2]);
+}
+
+void loop() {
+}
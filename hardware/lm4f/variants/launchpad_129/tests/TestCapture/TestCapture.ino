@@ -0,0 +1,89 @@
+/* TestCapture
+  Captures both edges of the D1 LED while the sketch toggles it (GPIO
+  interrupts see the pad level of an output too), then checks that every
+  edge was queued in order with alternating levels and rising cycle
+  counts, that a burst larger than the queue counts its overflows, and
+  that detachInterrupt() stops the capture. Nothing needs to be connected.
+*/
+
+#define PIN D1_LED
+#define EDGES 40
+
+EdgeEvent events[CAPTURE_BUFFER_SIZE];
+
+void toggle(int edges) {
+  int i;
+
+  for (i = 0; i < edges; i++) {
+    digitalWrite(PIN, (i & 1) ? LOW : HIGH);
+    delayMicroseconds(10);
+  }
+}
+
+void setup() {
+  unsigned long order = 0, levels = 0, pins = 0;
+  int n, i;
+
+  Serial.begin(115200);
+  Serial.println("\nTestCapture setup");
+  pinMode(PIN, OUTPUT);
+  digitalWrite(PIN, LOW);
+
+  attachCapture(PIN, CHANGE);
+  toggle(EDGES);
+  Serial.print("available, expect ");
+  Serial.print(EDGES);
+  Serial.print(": ");
+  Serial.println(captureAvailable());
+  n = captureRead(events, CAPTURE_BUFFER_SIZE);
+  Serial.print("read, expect ");
+  Serial.print(EDGES);
+  Serial.print(": ");
+  Serial.println(n);
+  for (i = 0; i < n; i++) {
+    if (events[i].pin != PIN)
+      pins++;
+    if (events[i].edge != ((i & 1) ? FALLING : RISING))
+      levels++;
+    if (i && (int32_t)(events[i].cycles - events[i - 1].cycles) <= 0)
+      order++;
+  }
+  Serial.print("wrong pin, expect 0: ");
+  Serial.println(pins);
+  Serial.print("wrong edge, expect 0: ");
+  Serial.println(levels);
+  Serial.print("out of order, expect 0: ");
+  Serial.println(order);
+  Serial.print("10 us apart in cycles, expect ");
+  Serial.print(F_CPU / 100000);
+  Serial.print(" to ");
+  Serial.print(F_CPU / 100000 * 3 / 2);
+  Serial.print(": ");
+  Serial.println((events[n - 1].cycles - events[0].cycles) / (n - 1));
+  Serial.print("empty after read, expect 0: ");
+  Serial.println(captureAvailable());
+
+  toggle(CAPTURE_BUFFER_SIZE + 10);
+  Serial.print("full, expect ");
+  Serial.print(CAPTURE_BUFFER_SIZE);
+  Serial.print(": ");
+  Serial.println(captureAvailable());
+  Serial.print("overflows, expect 10: ");
+  Serial.println(captureOverflows());
+  n = captureRead(events, 5);
+  Serial.print("partial read, expect 5: ");
+  Serial.println(n);
+  Serial.print("left, expect ");
+  Serial.print(CAPTURE_BUFFER_SIZE - 5);
+  Serial.print(": ");
+  Serial.println(captureAvailable());
+  captureRead(events, CAPTURE_BUFFER_SIZE);
+
+  detachInterrupt(PIN);
+  toggle(4);
+  Serial.print("after detach, expect 0: ");
+  Serial.println(captureAvailable());
+}
+
+void loop() {
+}
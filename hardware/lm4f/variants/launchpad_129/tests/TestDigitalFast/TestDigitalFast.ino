@@ -0,0 +1,67 @@
+/* TestDigitalFast
+  Checks that digitalWriteFast() and digitalReadFast() agree with
+  digitalRead(), then times 1000 toggles of an LED with digitalWrite(),
+  digitalWriteFast() on a runtime pin and on a constant pin, and prints
+  the toggle rates.
+*/
+
+#define TOGGLES 1000
+
+volatile uint8_t runtimePin = RED_LED;
+
+void rate(const char *what, uint32_t cycles) {
+  Serial.print(what);
+  Serial.print(": ");
+  Serial.print(cycles / TOGGLES);
+  Serial.print(" cycles, ");
+  Serial.print((uint32_t)((uint64_t)F_CPU * TOGGLES / cycles));
+  Serial.println(" toggles/s");
+}
+
+void setup() {
+  uint32_t start, slow, runtime, constant;
+  int i;
+
+  Serial.begin(115200);
+  Serial.println("\nTestDigitalFast setup");
+  pinMode(RED_LED, OUTPUT);
+
+  digitalWriteFast(RED_LED, HIGH);
+  Serial.print("constant write high, expect 1: ");
+  Serial.println(digitalRead(RED_LED));
+  Serial.print("constant read high, expect 1: ");
+  Serial.println(digitalReadFast(RED_LED));
+  digitalWriteFast(runtimePin, LOW);
+  Serial.print("runtime write low, expect 0: ");
+  Serial.println(digitalRead(RED_LED));
+  Serial.print("runtime read low, expect 0: ");
+  Serial.println(digitalReadFast(runtimePin));
+  Serial.print("not a pin, expect 0: ");
+  Serial.println(digitalReadFast(1));
+
+  start = profileCycles();
+  for (i = 0; i < TOGGLES; i++)
+    digitalWrite(RED_LED, i & 1);
+  slow = profileCycles() - start;
+
+  start = profileCycles();
+  for (i = 0; i < TOGGLES; i++)
+    digitalWriteFast(runtimePin, i & 1);
+  runtime = profileCycles() - start;
+
+  start = profileCycles();
+  for (i = 0; i < TOGGLES; i++)
+    digitalWriteFast(RED_LED, i & 1);
+  constant = profileCycles() - start;
+
+  rate("digitalWrite", slow);
+  rate("digitalWriteFast runtime pin", runtime);
+  rate("digitalWriteFast constant pin", constant);
+  Serial.print("runtime faster, expect 1: ");
+  Serial.println(runtime < slow);
+  Serial.print("constant cycles per toggle, expect 1 to 8: ");
+  Serial.println(constant / TOGGLES);
+}
+
+void loop() {
+}
@@ -0,0 +1,144 @@
+/* TestNumToStr
+  Compares the number to text conversion in numtostr.c against the per
+  digit divide (integers) and per digit floating point multiply (floats)
+  that Print used before, and checks that both give the same text.
+  Prints the average cost of one conversion in CPU cycles.
+*/
+
+#include "numtostr.h"
+
+#define COUNT 2000
+
+unsigned long values[COUNT];
+float floats[COUNT];
+unsigned long errors = 0;
+
+// The previous Print::printNumber, writing to a buffer
+size_t oldNumber(unsigned long n, uint8_t base, char *out) {
+  char buf[8 * sizeof(long) + 1];
+  char *str = &buf[sizeof(buf) - 1];
+
+  *str = '\0';
+  do {
+    unsigned long m = n;
+    n /= base;
+    char c = m - base * n;
+    *--str = c < 10 ? c + '0' : c + 'A' - 10;
+  } while (n);
+
+  strcpy(out, str);
+  return &buf[sizeof(buf) - 1] - str;
+}
+
+// The previous Print::printFloat, writing to a buffer
+size_t oldFloat(float number, uint8_t digits, char *out) {
+  char *p = out;
+
+  if (number < 0.0) {
+    *p++ = '-';
+    number = -number;
+  }
+
+  float rounding = 0.5;
+  for (uint8_t i = 0; i < digits; ++i)
+    rounding /= 10.0;
+  number += rounding;
+
+  unsigned long int_part = (unsigned long)number;
+  float remainder = number - (float)int_part;
+  p += oldNumber(int_part, 10, p);
+
+  if (digits > 0)
+    *p++ = '.';
+
+  while (digits-- > 0) {
+    remainder *= 10.0;
+    int toPrint = int(remainder);
+    *p++ = '0' + toPrint;
+    remainder -= toPrint;
+  }
+  *p = 0;
+  return p - out;
+}
+
+void report(const char *what, unsigned long oldUs, unsigned long newUs) {
+  Serial.print(what);
+  Serial.print(": old ");
+  Serial.print((float)oldUs * (F_CPU / 1000000) / COUNT, 1);
+  Serial.print(" cycles, new ");
+  Serial.print((float)newUs * (F_CPU / 1000000) / COUNT, 1);
+  Serial.println(" cycles per number");
+}
+
+void setup() {
+  char a[40], b[40];
+  unsigned long start, oldUs, newUs;
+  int i;
+
+  Serial.begin(115200);
+  Serial.println("\nTestNumToStr setup");
+
+  randomSeed(1);
+  for (i = 0; i < COUNT; i++) {
+    // Spread over all lengths, not just the (mostly 10 digit) full range
+    values[i] = random(0x7FFFFFFF) >> random(31);
+    floats[i] = (float)random(-1000000, 1000000) / 1000.0;
+  }
+
+  // Same text for integers in all bases Print uses
+  for (i = 0; i < COUNT; i++) {
+    oldNumber(values[i], 10, a); ultostr(values[i], b, 10, 1);
+    if (strcmp(a, b)) errors++;
+    oldNumber(values[i], 16, a); ultostr(values[i], b, 16, 1);
+    if (strcmp(a, b)) errors++;
+    oldNumber(values[i], 2, a); ultostr(values[i], b, 2, 1);
+    if (strcmp(a, b)) errors++;
+  }
+
+  // The old float code rounds from an inexact float sum, so only compare
+  // values that are not close to a tie
+  for (i = 0; i < COUNT; i++) {
+    oldFloat(floats[i], 2, a); ftostr(floats[i], b, 2);
+    if (strcmp(a, b) && (long)(fabs(floats[i]) * 1000 + 0.5) % 10 != 5)
+      errors++;
+  }
+
+  start = micros();
+  for (i = 0; i < COUNT; i++) oldNumber(values[i], 10, a);
+  oldUs = micros() - start;
+  start = micros();
+  for (i = 0; i < COUNT; i++) ultostr(values[i], a, 10, 1);
+  newUs = micros() - start;
+  report("DEC", oldUs, newUs);
+
+  start = micros();
+  for (i = 0; i < COUNT; i++) oldNumber(values[i], 16, a);
+  oldUs = micros() - start;
+  start = micros();
+  for (i = 0; i < COUNT; i++) ultostr(values[i], a, 16, 1);
+  newUs = micros() - start;
+  report("HEX", oldUs, newUs);
+
+  start = micros();
+  for (i = 0; i < COUNT; i++) oldNumber(values[i], 2, a);
+  oldUs = micros() - start;
+  start = micros();
+  for (i = 0; i < COUNT; i++) ultostr(values[i], a, 2, 1);
+  newUs = micros() - start;
+  report("BIN", oldUs, newUs);
+
+  start = micros();
+  for (i = 0; i < COUNT; i++) oldFloat(floats[i], 2, a);
+  oldUs = micros() - start;
+  start = micros();
+  for (i = 0; i < COUNT; i++) ftostr(floats[i], a, 2);
+  newUs = micros() - start;
+  report("float, 2 digits", oldUs, newUs);
+
+  Serial.print("Mismatches: ");
+  Serial.println(errors);
+  Serial.println(errors ? "FAIL" : "PASS");
+}
+
+void loop() {
+}
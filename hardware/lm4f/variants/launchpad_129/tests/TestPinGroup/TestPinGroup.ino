@@ -0,0 +1,70 @@
+/* TestPinGroup
+  Writes every value to the two port N LEDs as a group in port order and
+  in reverse order, reads them back with digitalRead() and pinGroupRead(),
+  checks that pins on two ports are refused, and times a group write
+  against the same two digitalWrite() calls.
+*/
+
+const uint8_t inOrder[] = { D2_LED, D1_LED };   // PN0, PN1
+const uint8_t reversed[] = { D1_LED, D2_LED };
+const uint8_t twoPorts[] = { D1_LED, D3_LED };  // PN1, PF4
+
+unsigned long roundTrip(const uint8_t *pins) {
+  PinGroup group;
+  unsigned long bad = 0;
+  uint8_t value;
+
+  pinGroupInit(&group, pins, 2);
+  for (value = 0; value < 4; value++) {
+    pinGroupWrite(&group, value);
+    if (digitalRead(pins[0]) != (value & 1) || digitalRead(pins[1]) != (value >> 1))
+      bad++;
+    if (pinGroupRead(&group) != value)
+      bad++;
+  }
+  return bad;
+}
+
+void setup() {
+  PinGroup group;
+  uint32_t start, single, grouped;
+  int i;
+
+  Serial.begin(115200);
+  Serial.println("\nTestPinGroup setup");
+  pinMode(D1_LED, OUTPUT);
+  pinMode(D2_LED, OUTPUT);
+
+  Serial.print("in order errors, expect 0: ");
+  Serial.println(roundTrip(inOrder));
+  Serial.print("reversed errors, expect 0: ");
+  Serial.println(roundTrip(reversed));
+  Serial.print("two ports accepted, expect 0: ");
+  Serial.println(pinGroupInit(&group, twoPorts, 2));
+  Serial.print("two ports read, expect 0: ");
+  Serial.println(pinGroupRead(&group));
+
+  start = profileCycles();
+  for (i = 0; i < 1000; i++) {
+    digitalWrite(D2_LED, i & 1);
+    digitalWrite(D1_LED, i & 2);
+  }
+  single = profileCycles() - start;
+
+  pinGroupInit(&group, inOrder, 2);
+  start = profileCycles();
+  for (i = 0; i < 1000; i++)
+    pinGroupWrite(&group, i);
+  grouped = profileCycles() - start;
+  pinGroupWrite(&group, 0);
+
+  Serial.print("digitalWrite x2 cycles: ");
+  Serial.println(single / 1000);
+  Serial.print("pinGroupWrite cycles: ");
+  Serial.println(grouped / 1000);
+  Serial.print("group faster, expect 1: ");
+  Serial.println(grouped < single);
+}
+
+void loop() {
+}
@@ -0,0 +1,60 @@
+/* TestProfile
+  Measures a fixed busy loop, an empty zone and a scoped zone, checks the
+  cycle counts against what delayMicroseconds() should take, then prints
+  the dump for hardware/tools/profile_report.py.
+*/
+
+static PROFILE_ZONE(empty, "empty");
+static PROFILE_ZONE(busy, "delayMicroseconds(100)");
+
+void scoped() {
+  PROFILE_SCOPE("scoped");
+  delayMicroseconds(10);
+}
+
+void setup() {
+  int i;
+
+  Serial.begin(115200);
+  Serial.println("\nTestProfile setup");
+
+  for (i = 0; i < 10; i++) {
+    PROFILE_BEGIN(empty);
+    PROFILE_END(empty);
+    PROFILE_BEGIN(busy);
+    delayMicroseconds(100);
+    PROFILE_END(busy);
+    scoped();
+  }
+
+  Serial.print("empty count, expect 10: ");
+  Serial.println(empty.count);
+  Serial.print("empty max, expect 0 to 8: ");
+  Serial.println(empty.max);
+  Serial.print("busy min, expect ");
+  Serial.print(F_CPU / 10000);
+  Serial.print(" to ");
+  Serial.print(F_CPU / 10000 + F_CPU / 1000000);
+  Serial.print(": ");
+  Serial.println(busy.min);
+  Serial.print("busy max, expect ");
+  Serial.print(F_CPU / 10000);
+  Serial.print(" to ");
+  Serial.print(F_CPU / 10000 + F_CPU / 100000);
+  Serial.print(": ");
+  Serial.println(busy.max);
+  Serial.print("busy total / 10, expect ");
+  Serial.print(busy.min);
+  Serial.print(" to ");
+  Serial.print(busy.max);
+  Serial.print(": ");
+  Serial.println((unsigned long)(busy.total / 10));
+
+  profileDump();
+  profileReset();
+  Serial.print("count after reset, expect 0: ");
+  Serial.println(busy.count + empty.count);
+}
+
+void loop() {
+}
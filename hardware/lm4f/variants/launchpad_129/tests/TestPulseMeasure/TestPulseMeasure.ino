@@ -0,0 +1,61 @@
+/* TestPulseMeasure
+  Connect PD_0 to PD_1. PD_0 puts out 1 kHz PWM at 25% duty on Timer0 A,
+  PD_1 measures it with the edge capture of Timer0 B: pulseIn() for the
+  high and low times, then pulseMeasureBegin()/pulseMeasureRead() for
+  period and duty over 100 cycles while the sketch keeps running. Also
+  checks that pulseIn() still times out on a pin without a timer.
+*/
+
+#define OUT PD_0
+#define IN PD_1
+
+
+void setup() {
+  uint32_t high, low, period = 0, duty = 0, cycles = 0, start;
+
+  Serial.begin(115200);
+  Serial.println("\nTestPulseMeasure setup");
+  pinMode(IN, INPUT);
+  analogFrequency(1000);
+  analogWrite(OUT, 64);
+  delay(10);
+
+  Serial.print("pulseIn HIGH us, expect 248 to 253: ");
+  Serial.println(pulseIn(IN, HIGH, 10000));
+  Serial.print("pulseIn LOW us, expect 747 to 753: ");
+  Serial.println(pulseIn(IN, LOW, 10000));
+
+  Serial.print("begin, expect 1: ");
+  Serial.println(pulseMeasureBegin(IN));
+  Serial.print("read before an edge, expect 0: ");
+  Serial.println(pulseMeasureRead(IN, &high, &low));
+  start = millis();
+  while (cycles < 100 && millis() - start < 1000) {
+    if (pulseMeasureRead(IN, &high, &low)) {
+      cycles++;
+      period = high + low;
+      duty = high * 1000 / period;
+    }
+  }
+  pulseMeasureEnd(IN);
+  Serial.print("cycles seen, expect 90 to 101: ");
+  Serial.println(cycles);
+  Serial.print("period cycles, expect ");
+  Serial.print(F_CPU / 1000 * 99 / 100);
+  Serial.print(" to ");
+  Serial.print(F_CPU / 1000 * 101 / 100);
+  Serial.print(": ");
+  Serial.println(period);
+  Serial.print("frequency Hz, expect 990 to 1010: ");
+  Serial.println(F_CPU / period);
+  Serial.print("duty per mille, expect 245 to 255: ");
+  Serial.println(duty);
+  Serial.print("read after end, expect 0: ");
+  Serial.println(pulseMeasureRead(IN, &high, &low));
+
+  Serial.print("no timer timeout, expect 0: ");
+  Serial.println(pulseIn(PN_2, HIGH, 1000));
+}
+
+void loop() {
+}
@@ -0,0 +1,81 @@
+/* TestSerialDMA
+  Benchmarks the CPU left over while Serial3 streams data in a loopback.
+  Connect X6_20 (PA_5, U3TX) to X6_18 (PA_4, U3RX).
+  For every baud rate the link is driven close to line rate, first with the
+  interrupt driven path and then with the uDMA path, and the time spent in
+  an idle counter is reported relative to an unloaded run.
+*/
+
+#define PORT     Serial3
+#define BLOCK    64
+#define WINDOW   1000000UL // us
+
+const unsigned long bauds[] = { 115200, 460800, 921600, 1500000, 3000000 };
+
+uint8_t block[BLOCK];
+unsigned long baseline;
+
+unsigned long run(unsigned long baud, bool load, unsigned long *received) {
+  unsigned long idle = 0;
+  unsigned long start, now, next;
+  // one block every period keeps the line at ~90% of the baud rate
+  unsigned long period = (BLOCK * 10UL * 1000000UL) / (baud - baud / 10);
+
+  *received = 0;
+  start = micros();
+  next = start;
+  while ((now = micros()) - start < WINDOW) {
+    if (load && (long)(now - next) >= 0) {
+      PORT.write(block, BLOCK);
+      next += period;
+    }
+    while (PORT.available()) {
+      PORT.read();
+      (*received)++;
+    }
+    idle++;
+  }
+  return idle;
+}
+
+void test(unsigned long baud, bool dma) {
+  unsigned long idle, received;
+
+  PORT.setDMA(dma);
+  PORT.begin(baud);
+  idle = run(baud, true, &received);
+  PORT.flush();
+  PORT.end();
+
+  Serial.print(baud);
+  Serial.print(dma ? "\tDMA\t" : "\tINT\t");
+  Serial.print(received);
+  Serial.print(" bytes\tidle ");
+  Serial.print((idle * 100UL) / baseline);
+  Serial.println("%");
+}
+
+void setup() {
+  unsigned long received;
+  int i;
+
+  Serial.begin(115200);
+  Serial.println("\nTestSerialDMA setup");
+  Serial.println("X6_20 (U3TX) must be connected to X6_18 (U3RX)\n");
+
+  for (i = 0; i < BLOCK; i++)
+    block[i] = 'A' + (i % 26);
+
+  PORT.begin(bauds[0]);
+  baseline = run(bauds[0], false, &received);
+  PORT.end();
+
+  Serial.println("baud\tmode\treceived\tCPU idle");
+  for (i = 0; i < sizeof(bauds) / sizeof(bauds[0]); i++) {
+    test(bauds[i], false);
+    test(bauds[i], true);
+  }
+}
+
+void loop() {
+}
@@ -0,0 +1,75 @@
+/* TestSerialRegion
+  Checks the zero-copy readRegion()/consume() and writeRegion()/commit()
+  calls across the wrap of the ring buffers.
+  Connect X6_20 (PA_5, U3TX) to X6_18 (PA_4, U3RX).
+  Frames of varying length are queued through writeRegion() into a 64 byte
+  transmit buffer and read back from a 64 byte receive buffer, so both
+  regions regularly end at the physical end of the buffer.
+*/
+
+#define PORT    Serial3
+#define FRAMES  500
+
+uint8_t sent = 0;
+uint8_t expected = 0;
+unsigned long wraps = 0;
+unsigned long errors = 0;
+
+void queue(int len) {
+  uint8_t *data;
+  size_t n, i;
+
+  while (len > 0) {
+    n = PORT.writeRegion(&data);
+    if (n > len) n = len;
+    for (i = 0; i < n; i++)
+      data[i] = sent++;
+    PORT.commit(n);
+    len -= n;
+  }
+}
+
+void drain(int len) {
+  const uint8_t *data;
+  size_t n, i;
+  unsigned long start = millis();
+
+  while (len > 0 && millis() - start < 100) {
+    n = PORT.readRegion(&data);
+    if (n == 0) continue;
+    if (n < PORT.available()) wraps++;
+    for (i = 0; i < n; i++)
+      if (data[i] != expected++) errors++;
+    PORT.consume(n);
+    len -= n;
+  }
+  if (len > 0) errors += len;
+}
+
+void setup() {
+  int i, len;
+
+  Serial.begin(115200);
+  Serial.println("\nTestSerialRegion setup");
+  Serial.println("X6_20 (U3TX) must be connected to X6_18 (U3RX)\n");
+
+  PORT.setBufferSize(64, 64);
+  PORT.begin(115200);
+
+  for (i = 0; i < FRAMES; i++) {
+    len = 1 + (i * 7) % 48;
+    queue(len);
+    drain(len);
+  }
+
+  Serial.print("frames = ");
+  Serial.println(FRAMES);
+  Serial.print("wraps  = ");
+  Serial.println(wraps);
+  Serial.print("errors = ");
+  Serial.println(errors);
+  Serial.println((errors == 0 && wraps > 0) ? "PASS" : "FAIL");
+}
+
+void loop() {
+}
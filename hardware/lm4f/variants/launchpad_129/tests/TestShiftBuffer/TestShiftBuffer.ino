@@ -0,0 +1,93 @@
+/* TestShiftBuffer
+  Shifts bytes out on the two port N LEDs and checks the last bit in each
+  bit order, shifts in from an LED held high and low, times a 64 byte
+  shiftOutBuffer() against 64 shiftOut() calls, then sends 64 bytes on
+  the SSI2 pins (PD_1 data, PD_3 clock): at 4 MHz that takes at least
+  128 us, and the pins must be back to GPIO afterwards. Nothing needs to
+  be connected.
+*/
+
+#define OUT D1_LED
+#define CLK D2_LED
+#define LEN 64
+
+uint8_t buf[LEN];
+
+unsigned long countBytes(uint8_t value) {
+  unsigned long n = 0;
+  int i;
+
+  for (i = 0; i < LEN; i++)
+    if (buf[i] == value)
+      n++;
+  return n;
+}
+
+void setup() {
+  uint32_t start, single, buffered;
+  int i;
+
+  Serial.begin(115200);
+  Serial.println("\nTestShiftBuffer setup");
+  pinMode(OUT, OUTPUT);
+  pinMode(CLK, OUTPUT);
+
+  buf[0] = 0x01;
+  shiftOutBuffer(OUT, CLK, MSBFIRST, buf, 1);
+  Serial.print("MSB first last bit, expect 1: ");
+  Serial.println(digitalRead(OUT));
+  shiftOutBuffer(OUT, CLK, LSBFIRST, buf, 1);
+  Serial.print("LSB first last bit, expect 0: ");
+  Serial.println(digitalRead(OUT));
+  buf[0] = 0x80;
+  shiftOutBuffer(OUT, CLK, LSBFIRST, buf, 1);
+  Serial.print("LSB first last bit, expect 1: ");
+  Serial.println(digitalRead(OUT));
+  Serial.print("clock left low, expect 0: ");
+  Serial.println(digitalRead(CLK));
+
+  digitalWrite(OUT, HIGH);
+  shiftInBuffer(OUT, CLK, MSBFIRST, buf, LEN);
+  Serial.print("ones shifted in, expect ");
+  Serial.print(LEN);
+  Serial.print(": ");
+  Serial.println(countBytes(0xFF));
+  digitalWrite(OUT, LOW);
+  shiftInBuffer(OUT, CLK, LSBFIRST, buf, LEN);
+  Serial.print("zeros shifted in, expect ");
+  Serial.print(LEN);
+  Serial.print(": ");
+  Serial.println(countBytes(0x00));
+
+  for (i = 0; i < LEN; i++)
+    buf[i] = i;
+  start = profileCycles();
+  for (i = 0; i < LEN; i++)
+    shiftOut(OUT, CLK, MSBFIRST, buf[i]);
+  single = profileCycles() - start;
+  start = profileCycles();
+  shiftOutBuffer(OUT, CLK, MSBFIRST, buf, LEN);
+  buffered = profileCycles() - start;
+  Serial.print("shiftOut cycles/byte: ");
+  Serial.println(single / LEN);
+  Serial.print("shiftOutBuffer cycles/byte: ");
+  Serial.println(buffered / LEN);
+  Serial.print("buffer faster, expect 1: ");
+  Serial.println(buffered < single);
+
+  pinMode(PD_1, OUTPUT);
+  pinMode(PD_3, OUTPUT);
+  start = micros();
+  shiftOutBuffer(PD_1, PD_3, MSBFIRST, buf, LEN);
+  Serial.print("SSI us, expect 128 to 400: ");
+  Serial.println(micros() - start);
+  digitalWrite(PD_1, HIGH);
+  Serial.print("data pin GPIO again, expect 1: ");
+  Serial.println(digitalRead(PD_1));
+  digitalWrite(PD_1, LOW);
+  Serial.print("data pin GPIO again, expect 0: ");
+  Serial.println(digitalRead(PD_1));
+}
+
+void loop() {
+}
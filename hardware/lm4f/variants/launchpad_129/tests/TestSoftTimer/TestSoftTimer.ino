@@ -0,0 +1,70 @@
+/* TestSoftTimer
+  Runs a periodic, a one-shot, a deferred and a stopped software timer
+  for a second and checks how often each one ran, and that the
+  one-shot ran on time.
+*/
+
+#include "wheeltimer.h"
+
+WheelTimer periodic, oneShot, deferred, stopped;
+volatile unsigned long periodicRuns, oneShotRuns, stoppedRuns;
+volatile unsigned long oneShotAt;
+unsigned long deferredRuns, deferredInInterrupt;
+
+void countRun(void *arg) {
+  (*(volatile unsigned long *)arg)++;
+}
+
+void oneShotRun(void *arg) {
+  oneShotAt = millis();
+  oneShotRuns++;
+}
+
+void deferredRun(void *arg) {
+  // SCB ICSR VECTACTIVE is 0 in thread mode
+  if (HWREG(NVIC_INT_CTRL) & 0x1FF) deferredInInterrupt++;
+  deferredRuns++;
+}
+
+void setup() {
+  unsigned long start;
+
+  Serial.begin(115200);
+  Serial.println("\nTestSoftTimer setup");
+
+  wheelTimerInit(&periodic, countRun, (void *)&periodicRuns, 0);
+  wheelTimerInit(&oneShot, oneShotRun, NULL, 0);
+  wheelTimerInit(&deferred, deferredRun, NULL, WHEELTIMER_DEFER);
+  wheelTimerInit(&stopped, countRun, (void *)&stoppedRuns, 0);
+
+  start = millis();
+  wheelTimerStart(&periodic, 10, 10);
+  wheelTimerStart(&oneShot, 250, 0);
+  wheelTimerStart(&deferred, 100, 100);
+  wheelTimerStart(&stopped, 500, 0);
+  wheelTimerStop(&stopped);
+
+  // wheelTimerRun() is called after each loop(), call it here as well
+  while (millis() - start < 1005)
+    wheelTimerRun();
+  wheelTimerStop(&periodic);
+  wheelTimerStop(&deferred);
+
+  Serial.print("periodic runs, expect 99 to 101: ");
+  Serial.println(periodicRuns);
+  Serial.print("one-shot runs, expect 1: ");
+  Serial.println(oneShotRuns);
+  Serial.print("one-shot after ms, expect 249 to 251: ");
+  Serial.println(oneShotAt - start);
+  Serial.print("deferred runs, expect 9 to 10: ");
+  Serial.println(deferredRuns);
+  Serial.print("deferred in interrupt, expect 0: ");
+  Serial.println(deferredInInterrupt);
+  Serial.print("stopped runs, expect 0: ");
+  Serial.println(stoppedRuns);
+  Serial.print("still active, expect 0: ");
+  Serial.println(wheelTimerActive(&periodic) + wheelTimerActive(&oneShot));
+}
+
+void loop() {
+}
@@ -0,0 +1,63 @@
+/* TestStreamMatcher
+  Runs Stream::find(), findUntil() and findMulti() on a Stream reading
+  from a string, including matches that overlap a false start, then the
+  matcher directly over a buffer. Each result is printed next to the one
+  expected.
+*/
+
+// A Stream that reads from a string, then times out
+class TextStream : public Stream {
+public:
+  TextStream(const char *text) : p(text) { setTimeout(0); }
+  int available() { return strlen(p); }
+  int read() { return *p ? *p++ : -1; }
+  int peek() { return *p ? *p : -1; }
+  void flush() {}
+  size_t write(uint8_t) { return 0; }
+  const char *p;
+};
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("\nTestStreamMatcher setup");
+
+  TextStream a("aaab");
+  Serial.print("find aab in aaab, expect 1: ");
+  Serial.println(a.find("aab"));
+
+  TextStream b("abcabd");
+  Serial.print("find abd in abcabd, expect 1: ");
+  Serial.println(b.find("abd"));
+
+  TextStream c("key: 1\r\n\r\nbody");
+  Serial.print("findUntil past terminator, expect 0: ");
+  Serial.println(c.findUntil("body", "\r\n\r\n"));
+  Serial.print("rest after terminator, expect 1: ");
+  Serial.println(c.find("body"));
+
+  TextStream d("HTTP/1.1 200 OK\r\nContent-Length: 12\r\n\r\n");
+  StreamMatcher m;
+  m.add("Content-Length: ");
+  m.add("\r\n\r\n");
+  Serial.print("findMulti header, expect 0: ");
+  Serial.println(d.findMulti(m));
+  Serial.print("parseInt after it, expect 12: ");
+  Serial.println(d.parseInt());
+  Serial.print("findMulti end of headers, expect 1: ");
+  Serial.println(d.findMulti(m));
+  Serial.print("findMulti timeout, expect -1: ");
+  Serial.println(d.findMulti(m));
+
+  const char buf[] = "xxERRORxxOK";
+  StreamMatcher e;
+  size_t used;
+  e.add("OK");
+  e.add("ERROR");
+  Serial.print("buffer match, expect 1: ");
+  Serial.println(e.match(buf, sizeof(buf) - 1, &used));
+  Serial.print("bytes used, expect 7: ");
+  Serial.println(used);
+}
+
+void loop() {
+}
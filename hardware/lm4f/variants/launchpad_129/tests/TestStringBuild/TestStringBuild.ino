@@ -0,0 +1,72 @@
+/* TestStringBuild
+  Times the ways sketches usually build Strings: short temporaries, a
+  line appended to a character at a time, a message joined with + and
+  numbers appended in a loop. Prints the average cost of each pattern in
+  CPU cycles and the text that comes out next to the one expected.
+*/
+
+#define COUNT 500
+
+void report(const char *what, unsigned long us) {
+  Serial.print(what);
+  Serial.print(": ");
+  Serial.print((float)us * (F_CPU / 1000000) / COUNT, 1);
+  Serial.println(" cycles");
+}
+
+void setup() {
+  unsigned long start;
+  String name = "sensor";
+  String unit = "mV";
+  String s;
+  unsigned long invalid = 0;
+  int i, j;
+
+  Serial.begin(115200);
+  Serial.println("\nTestStringBuild setup");
+
+  // Short Strings stay in the object, no heap block at all
+  start = micros();
+  for (i = 0; i < COUNT; i++) {
+    String t = "ok";
+    String u(i);
+    if (!t || !u) invalid++;
+  }
+  report("short temporaries", micros() - start);
+  Serial.print("invalid temporaries, expect 0: ");
+  Serial.println(invalid);
+
+  // One character at a time, as when collecting a line from Serial
+  start = micros();
+  for (i = 0; i < COUNT; i++) {
+    s = "";
+    for (j = 0; j < 64; j++) s += (char)('a' + j % 26);
+  }
+  report("64 single characters", micros() - start);
+  Serial.print("text, expect abcdefghijklmnopqrstuvwxyzab: ");
+  Serial.println(s.substring(0, 28));
+
+  // A message joined with +
+  start = micros();
+  for (i = 0; i < COUNT; i++)
+    s = name + ": " + i + " " + unit + ", limit " + 3300 + " " + unit;
+  report("message joined with +", micros() - start);
+  Serial.print("text, expect sensor: 499 mV, limit 3300 mV: ");
+  Serial.println(s);
+
+  // Numbers appended in a loop
+  start = micros();
+  for (i = 0; i < COUNT; i++) {
+    s = "";
+    for (j = 0; j < 16; j++) {
+      s += j * 1000;
+      s += ',';
+    }
+  }
+  report("16 numbers appended", micros() - start);
+  Serial.print("text, expect 0,1000,2000,3000,400: ");
+  Serial.println(s.substring(0, 20));
+}
+
+void loop() {
+}
@@ -0,0 +1,71 @@
+/* TestTask
+  Runs a sleeping task, one that waits for a flag with a timeout and one
+  that finishes, all while setup() sits in delay(), and checks how often
+  each one ran and that delay() was not stretched by them.
+*/
+
+#include "cotask.h"
+
+CoTask sleeper, waiter, finisher;
+unsigned long sleeperRuns, waiterWoken, waiterTimedOut, finisherRuns;
+bool flag;
+
+uint8_t sleeperTask(CoTask *task) {
+  COTASK_BEGIN(task);
+  for (;;) {
+    sleeperRuns++;
+    COTASK_SLEEP(task, 10);
+  }
+  COTASK_END(task);
+}
+
+uint8_t waiterTask(CoTask *task) {
+  COTASK_BEGIN(task);
+  COTASK_AWAIT_TIMEOUT(task, flag, 300);
+  if (flag) waiterWoken++;
+  COTASK_AWAIT_TIMEOUT(task, !flag, 100);
+  if (coTaskTimedOut(task)) waiterTimedOut++;
+  COTASK_END(task);
+}
+
+uint8_t finisherTask(CoTask *task) {
+  COTASK_BEGIN(task);
+  finisherRuns++;
+  COTASK_YIELD(task);
+  finisherRuns++;
+  COTASK_END(task);
+}
+
+void setup() {
+  unsigned long start, took;
+
+  Serial.begin(115200);
+  Serial.println("\nTestTask setup");
+
+  coTaskStart(&sleeper, sleeperTask, NULL);
+  coTaskStart(&waiter, waiterTask, NULL);
+  coTaskStart(&finisher, finisherTask, NULL);
+
+  start = micros();
+  delay(200);
+  flag = true;
+  delay(300);
+  took = micros() - start;
+  coTaskStop(&sleeper);
+
+  Serial.print("sleeper runs, expect 49 to 51: ");
+  Serial.println(sleeperRuns);
+  Serial.print("waiter woken, expect 1: ");
+  Serial.println(waiterWoken);
+  Serial.print("waiter timed out, expect 1: ");
+  Serial.println(waiterTimedOut);
+  Serial.print("finisher runs, expect 2: ");
+  Serial.println(finisherRuns);
+  Serial.print("delay us, expect 500000 to 500100: ");
+  Serial.println(took);
+  Serial.print("still active, expect 0: ");
+  Serial.println(coTaskActive(&sleeper) + coTaskActive(&waiter) + coTaskActive(&finisher));
+}
+
+void loop() {
+}
@@ -0,0 +1,86 @@
+/* TestTimebase
+  Checks the timebase arithmetic in timebase.h at the edges of a Timer5
+  wrap, with the wrap interrupt handled and still pending, against the
+  time computed directly from the cycle count. Then checks that the
+  live millis(), micros(), micros64() and nanos() agree and never go
+  back. The first part touches no hardware and also builds on a host.
+*/
+
+#include "timebase.h"
+
+unsigned long errors = 0;
+
+void expect(const char *what, uint64_t got, uint64_t want) {
+  if (got != want) {
+    errors++;
+    Serial.print(what);
+    Serial.print(": got ");
+    Serial.print((unsigned long)(got >> 32), HEX);
+    Serial.print(":");
+    Serial.print((unsigned long)got, HEX);
+    Serial.print(", expected ");
+    Serial.print((unsigned long)(want >> 32), HEX);
+    Serial.print(":");
+    Serial.println((unsigned long)want, HEX);
+  }
+}
+
+// The handler has counted `handled` of the wraps up to total cycle count t
+void model(uint64_t t, uint32_t handled) {
+  uint32_t wraps = t / TIMEBASE_WRAP_CYCLES;
+  uint32_t count = t % TIMEBASE_WRAP_CYCLES;
+  uint32_t w = timebaseWraps(handled, count, handled != wraps);
+
+  expect("wraps", w, wraps);
+  expect("micros64", timebaseMicros64(w, count), t / TIMEBASE_CYCLES_PER_US);
+  expect("nanos", timebaseNanos(w, count), t * 1000 / TIMEBASE_CYCLES_PER_US);
+  expect("micros", timebaseMicros(w, count), (uint32_t)(t / TIMEBASE_CYCLES_PER_US));
+  expect("millis", timebaseMillis(w, count), (uint32_t)(t / TIMEBASE_CYCLES_PER_MS));
+}
+
+void setup() {
+  static const uint32_t wraps[3] = { 1, 200, 200000 };
+  uint64_t last, now, wrap;
+  unsigned long i, j, m;
+
+  Serial.begin(115200);
+  Serial.println("\nTestTimebase setup");
+  Serial.print("Timer5 wraps every ");
+  Serial.print(TIMEBASE_WRAP_MS);
+  Serial.println(" ms");
+
+  // Around the first, 200th and 200000th wrap (micros() and millis()
+  // pass 2^32 in between), with the interrupt handled and pending
+  for (j = 0; j < 3; j++) {
+    wrap = wraps[j];
+    for (i = 0; i < 64; i++) {
+      now = wrap * TIMEBASE_WRAP_CYCLES - 32 + i;
+      model(now, now / TIMEBASE_WRAP_CYCLES);
+      if (i >= 32)
+        model(now, wrap - 1);
+    }
+  }
+
+  // Live readings never go back and agree with each other
+  last = micros64();
+  for (i = 0; i < 100000; i++) {
+    now = micros64();
+    if (now < last) errors++;
+    last = now;
+  }
+  now = micros64();
+  m = millis();
+  if ((unsigned long)(now / 1000) - m > 1) errors++;
+  now = micros64();
+  last = nanos() / 1000;
+  if (last - now > 2) errors++;
+
+  Serial.print("micros64() = ");
+  Serial.println((unsigned long)micros64());
+  Serial.print("Mismatches: ");
+  Serial.println(errors);
+  Serial.println(errors ? "FAIL" : "PASS");
+}
+
+void loop() {
+}
@@ -104,16 +104,107 @@ static const uint8_t PUSH1 = 31;
 static const uint8_t PUSH2 = 17;
 static const uint8_t TEMPSENSOR = 0;
 
-#ifdef ARDUINO_MAIN
-const uint32_t port_to_base[] = {
-        NOT_A_PORT,
-        (uint32_t) GPIO_PORTA_BASE,
-        (uint32_t) GPIO_PORTB_BASE,
-        (uint32_t) GPIO_PORTC_BASE,
-        (uint32_t) GPIO_PORTD_BASE,
-        (uint32_t) GPIO_PORTE_BASE,
+/*
+ * The tables as lists, so that inline code (digitalWriteFast) can look
+ * constant pins up at compile time
+ */
+#define PORT_TO_BASE_TABLE \
+        NOT_A_PORT,                 \
+        (uint32_t) GPIO_PORTA_BASE, \
+        (uint32_t) GPIO_PORTB_BASE, \
+        (uint32_t) GPIO_PORTC_BASE, \
+        (uint32_t) GPIO_PORTD_BASE, \
+        (uint32_t) GPIO_PORTE_BASE, \
         (uint32_t) GPIO_PORTF_BASE
-};
+
+#define DIGITAL_PIN_TO_PORT_TABLE \
+        NOT_A_PIN,      /*  dummy */                \
+        NOT_A_PIN,      /*  1 - 3.3V */             \
+        PB,      		/*  2 - PB5 */      \
+        PB,      		/*  3 - PB0 */      \
+        PB, 	  		/*  4 - PB1 */      \
+        PE, 	        /*  5 - PE4 */              \
+        PE, 	        /*  6 - PE5 */              \
+        PB,      		/*  7 - PB4 */      \
+        PA, 	        /*  8 - PA5 */              \
+        PA, 	        /*  9 - PA6 */              \
+        PA, 	        /*  10 - PA7 */             \
+        PA, 	        /*  11 - PA2 */             \
+        PA, 	        /*  12 - PA3 */             \
+        PA, 	        /*  13 - PA4 */             \
+        PB,      		/*  14 - PB6 */     \
+        PB,      		/*  15 - PB7 */     \
+        NOT_A_PIN,      /*  16 - RST */             \
+        PF,      		/*  17 - PF0 */     \
+        PE,             /*  18 - PE0 */             \
+        PB,       		/*  19 - PB2 */     \
+        NOT_A_PIN, 	    /*  20 - GND */         \
+        NOT_A_PIN, 	    /*  21 - VBUS */        \
+		NOT_A_PIN, 	    /*  22 - GND */ \
+        PD,      		/*  23 - PD0 */     \
+        PD,      		/*  24 - PD1 */     \
+        PD,      		/*  25 - PD2 */     \
+        PD,      		/*  26 - PD3 */     \
+        PE, 	        /*  27 - PE1 */             \
+        PE, 	        /*  28 - PE2 */             \
+        PE, 	        /*  29 - PE3 */             \
+        PF,      		/*  30 - PF1 */     \
+        PF, 	  		/*  31 - PF4 */     \
+        PD,      		/*  32 - PD7 */     \
+        PD,      		/*  33 - PD6 */     \
+        PC,      		/*  34 - PC7 */     \
+        PC,      		/*  35 - PC6 */     \
+        PC,      		/*  36 - PC5 */     \
+        PC,      		/*  37 - PC4 */     \
+        PB,       		/*  38 - PB3 */     \
+        PF,      		/*  39 - PF3 */     \
+        PF,      		/*  40 - PF2 */
+
+#define DIGITAL_PIN_TO_BIT_MASK_TABLE \
+        NOT_A_PIN,      /*  dummy */                \
+        NOT_A_PIN,      /*  1 - 3.3V */             \
+        BV(5),      	/*  2 - PB5 */              \
+        BV(0),      	/*  3 - PB0 */              \
+        BV(1), 	  		/*  4 - PB1 */      \
+        BV(4), 	        /*  5 - PE4 */              \
+        BV(5), 	        /*  6 - PE5 */              \
+        BV(4),      	/*  7 - PB4 */              \
+        BV(5), 	        /*  8 - PA5 */              \
+        BV(6), 	        /*  9 - PA6 */              \
+        BV(7), 	        /*  10 - PA7 */             \
+        BV(2), 	        /*  11 - PA2 */             \
+        BV(3), 	        /*  12 - PA3 */             \
+        BV(4), 	        /*  13 - PA4 */             \
+        BV(6),      	/*  14 - PB6 */             \
+        BV(7),      	/*  15 - PB7 */             \
+        NOT_A_PIN,      /*  16 - RST */             \
+        BV(0),      	/*  17 - PF0 */             \
+        BV(0),          /*  18 - PE0 */             \
+        BV(2),       	/*  19 - PB2 */             \
+        NOT_A_PIN, 	    /*  20 - GND */         \
+        NOT_A_PIN, 	    /*  21 - VBUS */        \
+		NOT_A_PIN, 	    /*  22 - GND */ \
+        BV(0),      	/*  23 - PD0 */             \
+        BV(1),      	/*  24 - PD1 */             \
+        BV(2),      	/*  25 - PD2 */             \
+        BV(3),      	/*  26 - PD3 */             \
+        BV(1), 	        /*  27 - PE1 */             \
+        BV(2), 	        /*  28 - PE2 */             \
+        BV(3), 	        /*  29 - PE3 */             \
+        BV(1),      	/*  30 - PF1 */             \
+        BV(4), 	  		/*  31 - PF4 */     \
+        BV(7),      	/*  32 - PD7 */             \
+        BV(6),      	/*  33 - PD6 */             \
+        BV(7),      	/*  34 - PC7 */             \
+        BV(6),      	/*  35 - PC6 */             \
+        BV(5),      	/*  36 - PC5 */             \
+        BV(4),      	/*  37 - PC4 */             \
+        BV(3),       	/*  38 - PB3 */             \
+        BV(3),      	/*  39 - PF3 */             \
+        BV(2),      	/*  40 - PF2 */
+
+#ifdef ARDUINO_MAIN
+const uint32_t port_to_base[] = { PORT_TO_BASE_TABLE };
 const uint8_t digital_pin_to_timer[] = {
         NOT_ON_TIMER,   /*  dummy */
         NOT_ON_TIMER,   /*  1 - 3.3V */
@@ -157,92 +248,8 @@ const uint8_t digital_pin_to_timer[] = {
         T1B1,      		/*  39 - PF3 */
         T1A1,      		/*  40 - PF2 */
 };
-const uint8_t digital_pin_to_port[] = {
-        NOT_A_PIN,      /*  dummy */
-        NOT_A_PIN,      /*  1 - 3.3V */
-        PB,      		/*  2 - PB5 */
-        PB,      		/*  3 - PB0 */
-        PB, 	  		/*  4 - PB1 */
-        PE, 	        /*  5 - PE4 */
-        PE, 	        /*  6 - PE5 */
-        PB,      		/*  7 - PB4 */
-        PA, 	        /*  8 - PA5 */
-        PA, 	        /*  9 - PA6 */
-        PA, 	        /*  10 - PA7 */
-        PA, 	        /*  11 - PA2 */
-        PA, 	        /*  12 - PA3 */
-        PA, 	        /*  13 - PA4 */
-        PB,      		/*  14 - PB6 */
-        PB,      		/*  15 - PB7 */
-        NOT_A_PIN,      /*  16 - RST */
-        PF,      		/*  17 - PF0 */
-        PE,             /*  18 - PE0 */
-        PB,       		/*  19 - PB2 */
-        NOT_A_PIN, 	    /*  20 - GND */
-        NOT_A_PIN, 	    /*  21 - VBUS */
-		NOT_A_PIN, 	    /*  22 - GND */
-        PD,      		/*  23 - PD0 */
-        PD,      		/*  24 - PD1 */
-        PD,      		/*  25 - PD2 */
-        PD,      		/*  26 - PD3 */
-        PE, 	        /*  27 - PE1 */
-        PE, 	        /*  28 - PE2 */
-        PE, 	        /*  29 - PE3 */
-        PF,      		/*  30 - PF1 */
-        PF, 	  		/*  31 - PF4 */
-        PD,      		/*  32 - PD7 */
-        PD,      		/*  33 - PD6 */
-        PC,      		/*  34 - PC7 */
-        PC,      		/*  35 - PC6 */
-        PC,      		/*  36 - PC5 */
-        PC,      		/*  37 - PC4 */
-        PB,       		/*  38 - PB3 */
-        PF,      		/*  39 - PF3 */
-        PF,      		/*  40 - PF2 */
-};
-const uint8_t digital_pin_to_bit_mask[] = {
-        NOT_A_PIN,      /*  dummy */
-        NOT_A_PIN,      /*  1 - 3.3V */
-        BV(5),      	/*  2 - PB5 */
-        BV(0),      	/*  3 - PB0 */
-        BV(1), 	  		/*  4 - PB1 */
-        BV(4), 	        /*  5 - PE4 */
-        BV(5), 	        /*  6 - PE5 */
-        BV(4),      	/*  7 - PB4 */
-        BV(5), 	        /*  8 - PA5 */
-        BV(6), 	        /*  9 - PA6 */
-        BV(7), 	        /*  10 - PA7 */
-        BV(2), 	        /*  11 - PA2 */
-        BV(3), 	        /*  12 - PA3 */
-        BV(4), 	        /*  13 - PA4 */
-        BV(6),      	/*  14 - PB6 */
-        BV(7),      	/*  15 - PB7 */
-        NOT_A_PIN,      /*  16 - RST */
-        BV(0),      	/*  17 - PF0 */
-        BV(0),          /*  18 - PE0 */
-        BV(2),       	/*  19 - PB2 */
-        NOT_A_PIN, 	    /*  20 - GND */
-        NOT_A_PIN, 	    /*  21 - VBUS */
-		NOT_A_PIN, 	    /*  22 - GND */
-        BV(0),      	/*  23 - PD0 */
-        BV(1),      	/*  24 - PD1 */
-        BV(2),      	/*  25 - PD2 */
-        BV(3),      	/*  26 - PD3 */
-        BV(1), 	        /*  27 - PE1 */
-        BV(2), 	        /*  28 - PE2 */
-        BV(3), 	        /*  29 - PE3 */
-        BV(1),      	/*  30 - PF1 */
-        BV(4), 	  		/*  31 - PF4 */
-        BV(7),      	/*  32 - PD7 */
-        BV(6),      	/*  33 - PD6 */
-        BV(7),      	/*  34 - PC7 */
-        BV(6),      	/*  35 - PC6 */
-        BV(5),      	/*  36 - PC5 */
-        BV(4),      	/*  37 - PC4 */
-        BV(3),       	/*  38 - PB3 */
-        BV(3),      	/*  39 - PF3 */
-        BV(2),      	/*  40 - PF2 */
-};
+const uint8_t digital_pin_to_port[] = { DIGITAL_PIN_TO_PORT_TABLE };
+const uint8_t digital_pin_to_bit_mask[] = { DIGITAL_PIN_TO_BIT_MASK_TABLE };
 
 const uint32_t timer_to_offset[] = {
         TIMER0,
@@ -5,6 +5,7 @@
 #include <stdint.h>
 #include <string.h>
 #include <math.h>
+#include "pingroup.h"
 
 #include "binary.h"
 
@@ -173,6 +174,8 @@ void loop(void);
 
 void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t val);
 uint8_t shiftIn(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder);
+void shiftOutBuffer(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, const uint8_t *buf, size_t len);
+void shiftInBuffer(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t *buf, size_t len);
 unsigned long pulseIn(uint8_t pin, uint8_t state, unsigned long timeout);
 void pinMode(uint8_t, uint8_t);
 void pinMode_int(uint8_t, uint16_t);
@@ -183,6 +186,11 @@ void analogWrite(uint8_t, int);
 void analogReference(uint16_t);
 void analogFrequency(uint32_t);
 void analogResolution(uint16_t);
+void analogReferenceHold(boolean hold);
+boolean analogReadBlock(const uint8_t *pins, uint8_t count, uint16_t *buffer, uint16_t samples, uint32_t rate);
+boolean analogReadBlockStart(const uint8_t *pins, uint8_t count, uint16_t *buffer, uint16_t samples, uint32_t rate);
+boolean analogReadBlockDone(void);
+void analogReadBlockStop(void);
 
 
 
@@ -36,10 +36,12 @@
 #include "Energia.h"
 #include "wiring_private.h"
 #include "usci_isr_handler.h"
+#include "dma_isr_handler.h"
 
 #if defined(__MSP430_HAS_USCI__) || defined(__MSP430_HAS_USCI_A0__) || defined(__MSP430_HAS_USCI_A1__) || defined(__MSP430_HAS_EUSCI_A0__) || defined(__MSP430_HAS_EUSCI_A1__)
 
 #include "HardwareSerial.h"
+#include "ringspan.h"
 
 #define UCAxCTLW0     UCA0CTLW0 
 #define UCAxCTL0      UCA0CTL0
@@ -73,25 +75,80 @@
 #endif
 #define UCAxIV        UCA0IV
 
+/* Default ring size, may be overridden on the compiler command line or per
+ * port at run time with setBufferSize(). Parts without a DMA controller are
+ * the small value line parts that cannot spare more RAM. */
+#ifndef SERIAL_BUFFER_SIZE
+#if defined(__MSP430_HAS_DMAX_3__)
+#define SERIAL_BUFFER_SIZE 64
+#else
 #define SERIAL_BUFFER_SIZE 16
+#endif
+#endif
+
+#if (SERIAL_BUFFER_SIZE & (SERIAL_BUFFER_SIZE - 1))
+#error "SERIAL_BUFFER_SIZE must be a power of two"
+#endif
+
+/* setBufferSize() clamps larger requests, which also keeps the rounding to a
+ * power of two within an unsigned int. */
+#ifndef SERIAL_BUFFER_MAX
+#define SERIAL_BUFFER_MAX 1024
+#endif
 
+/* DMA mode: channel 0 receives into the ring in repeated (circular) mode,
+ * channel 1 transmits the contiguous part of the ring. Channel 2 is the
+ * ADC block sampling of wiring_analog.c. One port at a time can use it. */
+#ifdef DMA_ISR_AVAILABLE
+#define SERIAL_DMA
+#if defined(__MSP430_HAS_EUSCI_A0__)
+#define DMA_TRIGGER_UCA0RX 14
+#define DMA_TRIGGER_UCA0TX 15
+#define DMA_TRIGGER_UCA1RX 16
+#define DMA_TRIGGER_UCA1TX 17
+#else
+#define DMA_TRIGGER_UCA0RX 16
+#define DMA_TRIGGER_UCA0TX 17
+#define DMA_TRIGGER_UCA1RX 20
+#define DMA_TRIGGER_UCA1TX 21
+#endif
+#endif
+
+/* The size is always a power of two so that indices wrap with a mask
+ * instead of a division, which msp430 does not have in hardware. */
 struct ring_buffer
 {
-	unsigned char buffer[SERIAL_BUFFER_SIZE];
+	unsigned char *buffer;
+	unsigned int mask;
 	volatile unsigned int head;
 	volatile unsigned int tail;
+	volatile unsigned int dropped;          // received bytes lost to a full ring
+	uint8_t allocated;
 };
 
-ring_buffer rx_buffer  =  { { 0 }, 0, 0 };
-ring_buffer tx_buffer  =  { { 0 }, 0, 0 };
+static unsigned char rx_storage[SERIAL_BUFFER_SIZE];
+static unsigned char tx_storage[SERIAL_BUFFER_SIZE];
+ring_buffer rx_buffer  =  { rx_storage, SERIAL_BUFFER_SIZE - 1, 0, 0, 0, 0 };
+ring_buffer tx_buffer  =  { tx_storage, SERIAL_BUFFER_SIZE - 1, 0, 0, 0, 0 };
 #ifdef SERIAL1_AVAILABLE
-ring_buffer rx_buffer1  =  { { 0 }, 0, 0 };
-ring_buffer tx_buffer1  =  { { 0 }, 0, 0 };
+static unsigned char rx_storage1[SERIAL_BUFFER_SIZE];
+static unsigned char tx_storage1[SERIAL_BUFFER_SIZE];
+ring_buffer rx_buffer1  =  { rx_storage1, SERIAL_BUFFER_SIZE - 1, 0, 0, 0, 0 };
+ring_buffer tx_buffer1  =  { tx_storage1, SERIAL_BUFFER_SIZE - 1, 0, 0, 0, 0 };
+#endif
+
+#ifdef SERIAL_DMA
+static HardwareSerial *dma_owner;
+static ring_buffer *dma_tx_ring;
+static uint8_t dma_offset;
+static volatile unsigned int dma_tx_count;
+static volatile unsigned int dma_rx_laps;       // laps of the DMA round the receive ring
+static unsigned int dma_rx_tail_laps;           // and of its tail
 #endif
 
 inline void store_char(unsigned char c, ring_buffer *buffer)
 {
-	unsigned int i = (unsigned int)(buffer->head + 1) % SERIAL_BUFFER_SIZE;
+	unsigned int i = (unsigned int)(buffer->head + 1) & buffer->mask;
 
 	// if we should be storing the received character into the location
 	// just before the tail (meaning that the head would advance to the
@@ -100,6 +157,8 @@ inline void store_char(unsigned char c, ring_buffer *buffer)
 	if (i != buffer->tail) {
 		buffer->buffer[buffer->head] = c;
 		buffer->head = i;
+	} else {
+		buffer->dropped++;
 	}
 }
 
@@ -118,9 +177,135 @@ void serialEventRun(void)
 #endif
 }
 
+/* Swap the ring storage for one of the requested size. */
+static void resize_ring(ring_buffer *ring, unsigned int size)
+{
+	unsigned char *buffer;
+
+	if (size == 0 || size == ring->mask + 1)
+		return;
+
+	buffer = (unsigned char *)malloc(size);
+	if (buffer == NULL)
+		return;
+
+	if (ring->allocated)
+		free(ring->buffer);
+
+	ring->buffer = buffer;
+	ring->mask = size - 1;
+	ring->head = ring->tail = 0;
+	ring->allocated = 1;
+}
+
+static unsigned int round_up_power_of_two(unsigned int size)
+{
+	unsigned int p = 2;     /* one slot stays empty, a ring of one holds nothing */
+
+	if (size > SERIAL_BUFFER_MAX)
+		size = SERIAL_BUFFER_MAX;
+	while (p < size)
+		p <<= 1;
+
+	return p;
+}
+
+#ifdef SERIAL_DMA
+/* Start transmitting the contiguous part of the ring, if any and if the
+ * channel is idle. Called from write() and from the DMA interrupt. */
+static void dma_tx_start(void)
+{
+	ring_buffer *ring = dma_tx_ring;
+	unsigned int n;
+
+	uint16_t oldSREG = READ_SR;
+	__dint();
+
+	if (dma_tx_count == 0 && ring->head != ring->tail) {
+		n = (ring->head > ring->tail) ? ring->head - ring->tail : ring->mask + 1 - ring->tail;
+
+		DMA1SA = (unsigned int)(ring->buffer + ring->tail);
+		DMA1DA = (unsigned int)(&(UCAxTXBUF) + dma_offset);
+		DMA1SZ = n;
+		dma_tx_count = n;
+		DMA1CTL = DMADT_0 | DMASRCINCR_3 | DMADSTINCR_0 | DMASBDB | DMAIE | DMAEN;
+
+		/* The USCI triggers the DMA on the rising edge of UCTXIFG. If
+		 * the flag was already up, the edge was missed: replay it. */
+		if (*(&(UCAxIFG) + dma_offset) & UCTXIFG) {
+			*(&(UCAxIFG) + dma_offset) &= ~UCTXIFG;
+			*(&(UCAxIFG) + dma_offset) |= UCTXIFG;
+		}
+	}
+
+	WRITE_SR(oldSREG);
+}
+
+/* Transmit block done, release it and send the next one. Called from the
+ * DMA interrupt in dma_isr_handler.c. */
+void uart_dma_tx_isr(void)
+{
+	dma_tx_ring->tail = (dma_tx_ring->tail + dma_tx_count) & dma_tx_ring->mask;
+	dma_tx_count = 0;
+	dma_tx_start();
+}
+
+/* Receive lap done. Called from the DMA interrupt in dma_isr_handler.c. */
+void uart_dma_rx_isr(void)
+{
+	dma_rx_laps++;
+}
+
+/* In DMA mode the receive head is the position of the DMA in the ring.
+ * The DMA interrupt counts its laps, read() and consume() those of the
+ * tail. A DMA a full ring ahead of the tail has written over unread bytes:
+ * the ring is emptied up to the DMA and its bytes are counted as dropped. */
+void HardwareSerial::syncRxHead(void)
+{
+	unsigned int size = _rx_buffer->mask + 1;
+	unsigned int head, laps, ahead;
+	uint16_t oldSREG;
+
+	if (dma_owner != this)
+		return;
+
+	oldSREG = READ_SR;
+	__dint();
+	head = (size - DMA0SZ) & _rx_buffer->mask;
+	laps = dma_rx_laps;
+	// A lap ended but its interrupt has not run: count it, unless head
+	// was read just before the end of that lap
+	if ((DMA0CTL & DMAIFG) && head < size / 2)
+		laps++;
+	WRITE_SR(oldSREG);
+
+	ahead = laps - dma_rx_tail_laps;
+	if (ahead > 1 || (ahead == 1 && head >= _rx_buffer->tail)) {
+		_rx_buffer->dropped += ahead * size + head - _rx_buffer->tail;
+		_rx_buffer->tail = head;
+		dma_rx_tail_laps = laps;
+	}
+	_rx_buffer->head = head;
+}
+#endif
+
 // Public Methods //////////////////////////////////////////////////////////////
 #define SMCLK F_CPU //SMCLK = F_CPU for now
 
+void HardwareSerial::setBufferSize(unsigned int txsize, unsigned int rxsize)
+{
+	/* 0 keeps the current size */
+	if (txsize > 0)
+		txSize = round_up_power_of_two(txsize);
+	if (rxsize > 0)
+		rxSize = round_up_power_of_two(rxsize);
+}
+
+void HardwareSerial::setDMA(bool enable)
+{
+	dma = enable;
+}
+
 void HardwareSerial::begin(unsigned long baud)
 {
 	unsigned int mod;
@@ -139,6 +324,10 @@ void HardwareSerial::begin(unsigned long baud)
 
 	divider=(SMCLK<<4)/baud;
 
+	resize_ring(_rx_buffer, rxSize);
+	_rx_buffer->dropped = 0;
+	resize_ring(_tx_buffer, txSize);
+
 	pinMode_int(rxPin, rxPinMode);
 	pinMode_int(txPin, txPinMode);
 
@@ -175,6 +364,30 @@ void HardwareSerial::begin(unsigned long baud)
 	*(&(UCAxMCTL) + uartOffset) = (unsigned char)(oversampling ? UCOS16:0) | mod;
 #endif	
 	*(&(UCAxCTL1) + uartOffset) &= ~UCSWRST;
+#ifdef SERIAL_DMA
+	if (dma && (dma_owner == NULL || dma_owner == this)) {
+		dma_isr_install();
+		dma_owner = this;
+		dma_tx_ring = _tx_buffer;
+		dma_offset = uartOffset;
+		dma_tx_count = 0;
+		dma_rx_laps = dma_rx_tail_laps = 0;
+		_rx_buffer->head = _rx_buffer->tail = 0;
+
+		DMACTL4 = DMARMWDIS;
+		DMACTL0 = (uartOffset ? DMA_TRIGGER_UCA1RX : DMA_TRIGGER_UCA0RX)
+			| ((uartOffset ? DMA_TRIGGER_UCA1TX : DMA_TRIGGER_UCA0TX) << 8);
+
+		/* Repeated single transfers wrap the destination back to the start
+		 * of the ring after every lap: a circular receive buffer with one
+		 * interrupt per lap, which only counts the laps. */
+		DMA0SA = (unsigned int)(&(UCAxRXBUF) + uartOffset);
+		DMA0DA = (unsigned int)_rx_buffer->buffer;
+		DMA0SZ = _rx_buffer->mask + 1;
+		DMA0CTL = DMADT_4 | DMASRCINCR_0 | DMADSTINCR_3 | DMASBDB | DMAIE | DMAEN;
+		return;
+	}
+#endif
 #if defined(__MSP430_HAS_USCI_A0__) || defined(__MSP430_HAS_USCI_A1__) || defined(__MSP430_HAS_EUSCI_A0__) || defined(__MSP430_HAS_EUSCI_A1__)
 	*(&(UCAxIE) + uartOffset) |= UCRXIE;
 #else
@@ -187,16 +400,29 @@ void HardwareSerial::end()
 	// wait for transmission of outgoing data
 	while (_tx_buffer->head != _tx_buffer->tail);
 
+#ifdef SERIAL_DMA
+	if (dma_owner == this) {
+		DMA0CTL = 0;
+		DMA1CTL = 0;
+		dma_owner = NULL;
+	}
+#endif
 	_rx_buffer->head = _rx_buffer->tail;
 }
 
 int HardwareSerial::available(void)
 {
-	return (unsigned int)(SERIAL_BUFFER_SIZE + _rx_buffer->head - _rx_buffer->tail) % SERIAL_BUFFER_SIZE;
+#ifdef SERIAL_DMA
+	syncRxHead();
+#endif
+	return (unsigned int)(_rx_buffer->head - _rx_buffer->tail) & _rx_buffer->mask;
 }
 
 int HardwareSerial::peek(void)
 {
+#ifdef SERIAL_DMA
+	syncRxHead();
+#endif
 	if (_rx_buffer->head == _rx_buffer->tail) {
 		return -1;
 	} else {
@@ -206,12 +432,19 @@ int HardwareSerial::peek(void)
 
 int HardwareSerial::read(void)
 {
+#ifdef SERIAL_DMA
+	syncRxHead();
+#endif
 	// if the head isn't ahead of the tail, we don't have any characters
 	if (_rx_buffer->head == _rx_buffer->tail) {
 		return -1;
 	} else {
 		unsigned char c = _rx_buffer->buffer[_rx_buffer->tail];
-		_rx_buffer->tail = (unsigned int)(_rx_buffer->tail + 1) % SERIAL_BUFFER_SIZE;
+		_rx_buffer->tail = (unsigned int)(_rx_buffer->tail + 1) & _rx_buffer->mask;
+#ifdef SERIAL_DMA
+		if (_rx_buffer->tail == 0 && dma_owner == this)
+			dma_rx_tail_laps++;
+#endif
 		return c;
 	}
 }
@@ -223,7 +456,7 @@ void HardwareSerial::flush()
 
 size_t HardwareSerial::write(uint8_t c)
 {
-	unsigned int i = (_tx_buffer->head + 1) % SERIAL_BUFFER_SIZE;
+	unsigned int i = (_tx_buffer->head + 1) & _tx_buffer->mask;
 	
 	// If the output buffer is full, there's nothing for it other than to
 	// wait for the interrupt handler to empty it a bit
@@ -233,6 +466,13 @@ size_t HardwareSerial::write(uint8_t c)
 	_tx_buffer->buffer[_tx_buffer->head] = c;
 	_tx_buffer->head = i;
 
+#ifdef SERIAL_DMA
+	if (dma_owner == this) {
+		dma_tx_start();
+		return 1;
+	}
+#endif
+
 #if defined(__MSP430_HAS_USCI_A0__) || defined(__MSP430_HAS_USCI_A1__) || defined(__MSP430_HAS_EUSCI_A0__) || defined(__MSP430_HAS_EUSCI_A1__)
 	*(&(UCAxIE) + uartOffset) |= UCTXIE;
 #else
@@ -242,6 +482,66 @@ size_t HardwareSerial::write(uint8_t c)
 	return 1;
 }
 
+size_t HardwareSerial::readRegion(const uint8_t **data)
+{
+#ifdef SERIAL_DMA
+	syncRxHead();
+#endif
+	*data = _rx_buffer->buffer + _rx_buffer->tail;
+	return ringReadSpan(_rx_buffer->tail, _rx_buffer->head, _rx_buffer->mask + 1);
+}
+
+void HardwareSerial::consume(size_t n)
+{
+	if (n > (size_t)available())
+		n = available();
+
+#ifdef SERIAL_DMA
+	if (_rx_buffer->tail + n > _rx_buffer->mask && dma_owner == this)
+		dma_rx_tail_laps++;
+#endif
+	_rx_buffer->tail = (unsigned int)(_rx_buffer->tail + n) & _rx_buffer->mask;
+}
+
+size_t HardwareSerial::writeRegion(uint8_t **data)
+{
+	*data = _tx_buffer->buffer + _tx_buffer->head;
+	return ringWriteSpan(_tx_buffer->tail, _tx_buffer->head, _tx_buffer->mask + 1);
+}
+
+void HardwareSerial::commit(size_t n)
+{
+	uint8_t *data;
+
+	if (n > writeRegion(&data))
+		n = writeRegion(&data);
+	if (n == 0)
+		return;
+
+	_tx_buffer->head = (unsigned int)(_tx_buffer->head + n) & _tx_buffer->mask;
+
+#ifdef SERIAL_DMA
+	if (dma_owner == this) {
+		dma_tx_start();
+		return;
+	}
+#endif
+
+#if defined(__MSP430_HAS_USCI_A0__) || defined(__MSP430_HAS_USCI_A1__) || defined(__MSP430_HAS_EUSCI_A0__) || defined(__MSP430_HAS_EUSCI_A1__)
+	*(&(UCAxIE) + uartOffset) |= UCTXIE;
+#else
+	*(&(UC0IE) + uartOffset) |= UCA0TXIE;
+#endif	
+}
+
+unsigned int HardwareSerial::rxDropped(void)
+{
+#ifdef SERIAL_DMA
+	syncRxHead();
+#endif
+	return _rx_buffer->dropped;
+}
+
 HardwareSerial::operator bool() {
 	return true;
 }
@@ -278,7 +578,7 @@ void uart_tx_isr(uint8_t offset)
 	}
 
 	unsigned char c = tx_buffer_ptr->buffer[tx_buffer_ptr->tail];
-	tx_buffer_ptr->tail = (tx_buffer_ptr->tail + 1) % SERIAL_BUFFER_SIZE;
+	tx_buffer_ptr->tail = (tx_buffer_ptr->tail + 1) & tx_buffer_ptr->mask;
 	*(&(UCAxTXBUF) + offset) = c;
 }
 // Preinstantiate Objects //////////////////////////////////////////////////////
@@ -46,6 +46,10 @@ class HardwareSerial : public Stream
 		uint8_t rxPin;
 		uint8_t txPin;
 		uint8_t lock;
+		uint16_t rxSize;
+		uint16_t txSize;
+		bool dma;
+		void syncRxHead(void);
 	public:
 		HardwareSerial(ring_buffer *rx_buffer, ring_buffer *tx_buffer, uint8_t uartOffset, uint16_t rxPinMode, uint16_t txPinMode, uint8_t rxPin, uint8_t txPin)
 		: _rx_buffer(rx_buffer)
@@ -54,7 +58,21 @@ class HardwareSerial : public Stream
 		, rxPinMode(rxPinMode)
 		, txPinMode(txPinMode)
 		, rxPin(rxPin)
-		, txPin(txPin) {}
+		, txPin(txPin)
+		, rxSize(0)
+		, txSize(0)
+		, dma(false) {}
+		// Ring sizes (rounded up to a power of two, at most
+		// SERIAL_BUFFER_MAX, 0 to keep the current one) and DMA mode take
+		// effect at the next begin(). DMA mode is available on parts with
+		// a DMA controller, for one port at a time. In DMA mode the
+		// receive ring takes one interrupt per lap; if more than a ring
+		// arrives between two reads, the DMA writes over unread bytes and
+		// the next read empties the ring (see rxDropped()).
+		void setBufferSize(unsigned int txsize, unsigned int rxsize);
+		void setDMA(bool enable);
+		// Received bytes lost to a full ring since begin()
+		unsigned int rxDropped(void);
 		void begin(unsigned long);
 		void end();
 		virtual int available(void);
@@ -64,6 +82,14 @@ class HardwareSerial : public Stream
 		virtual size_t write(uint8_t);
 		using Print::write; // pull in write(str) and write(buf, size) from Print
 		operator bool();
+		// Zero-copy access to the ring buffers. readRegion() returns the
+		// contiguous run of received bytes, consume() releases them.
+		// writeRegion() returns the contiguous free space of the transmit
+		// buffer, commit() queues what was written there.
+		size_t readRegion(const uint8_t **data);
+		void consume(size_t n);
+		size_t writeRegion(uint8_t **data);
+		void commit(size_t n);
 };
 
 extern HardwareSerial Serial;
@@ -31,10 +31,16 @@
 #define OCT 8
 #define BIN 2
 
+// Stack space used to gather the output of one print()/println() call
+#ifndef PRINT_BUFFER_SIZE
+#define PRINT_BUFFER_SIZE 32
+#endif
+
 class Print
 {
   private:
     int write_error;
+    size_t printSigned(long, int);
     size_t printNumber(unsigned long, uint8_t);
     size_t printFloat(double, uint8_t);
 
@@ -67,6 +73,8 @@ class Print
     size_t print(unsigned long, int = DEC);
     size_t print(double, int = 2);
     size_t print(const Printable&);
+    // No heap: conversions other than %s are cut off at PRINT_BUFFER_SIZE - 1
+    size_t printf(const char *format, ...) __attribute__ ((format (printf, 2, 3)));
 
     //size_t println(const __FlashStringHelper *);
     size_t println(const String &s);
@@ -25,11 +25,13 @@
 
 #define PARSE_TIMEOUT 1000  // default number of milli-seconds to wait
 #define NO_SKIP_CHAR  1  // a magic char not found in a valid ASCII numeric field
+#define READ_CHUNK    16 // bytes readString() moves per bulk read
 
 // private method to read stream with timeout
 int Stream::timedRead()
 {
-  int c;
+  int c = read();
+  if (c >= 0) return c;  // no need to look at the clock
   _startMillis = millis();
   do {
     c = read();
@@ -38,6 +40,20 @@ int Stream::timedRead()
   return -1;     // -1 indicates timeout
 }
 
+// private method to read what is available, waiting up to the timeout
+// for the first byte. returns 0 if timed out
+int Stream::timedRead(uint8_t *buffer, size_t size)
+{
+  int n = read(buffer, size);
+  if (n > 0) return n;
+  _startMillis = millis();
+  do {
+    n = read(buffer, size);
+    if (n > 0) return n;
+  } while(millis() - _startMillis < _timeout);
+  return 0;
+}
+
 // private method to peek stream with timeout
 int Stream::timedPeek()
 {
@@ -67,6 +83,17 @@ int Stream::peekNextDigit()
 // Public Methods
 //////////////////////////////////////////////////////////////
 
+// reads up to size bytes that are available without waiting, one read()
+// at a time. returns the number of bytes read
+int Stream::read(uint8_t *buffer, size_t size)
+{
+  size_t count = 0;
+  int c;
+  while (count < size && (c = read()) >= 0)
+    buffer[count++] = (uint8_t)c;
+  return count;
+}
+
 void Stream::setTimeout(unsigned long timeout)  // sets the maximum number of milliseconds to wait
 {
   _timeout = timeout;
@@ -88,7 +115,7 @@ bool Stream::find(char *target, size_t length)
 // as find but search ends if the terminator string is found
 bool  Stream::findUntil(char *target, char *terminator)
 {
-  return findUntil(target, strlen(target), terminator, strlen(terminator));
+  return findUntil(target, strlen(target), terminator, terminator ? strlen(terminator) : 0);
 }
 
 // reads data from the stream until the target string of the given length is found
@@ -96,32 +123,27 @@ bool  Stream::findUntil(char *target, char *terminator)
 // returns true if target string is found, false if terminated or timed out
 bool Stream::findUntil(char *target, size_t targetLen, char *terminator, size_t termLen)
 {
-  size_t index = 0;  // maximum target string length is 64k bytes!
-  size_t termIndex = 0;
-  int c;
-  
-  if( *target == 0)
+  StreamMatcher matcher;
+
+  if( *target == 0 || targetLen == 0)
     return true;   // return true if target is a null string
-  while( (c = timedRead()) > 0){
-    
-    if(c != target[index])
-      index = 0; // reset index if any char does not match
-    
-    if( c == target[index]){
-      //////Serial.print("found "); Serial.write(c); Serial.print("index now"); Serial.println(index+1);
-      if(++index >= targetLen){ // return true if all chars in the target match
-        return true;
-      }
-    }
-    
-    if(termLen > 0 && c == terminator[termIndex]){
-      if(++termIndex >= termLen)
-        return false;       // return false if terminate string found before target string
-    }
-    else
-      termIndex = 0;
+  matcher.add(target, targetLen);
+  if (termLen > 0)
+    matcher.add(terminator, termLen);
+  return findMulti(matcher) == 0;
+}
+
+// reads data from the stream until one of the matcher's patterns is found
+// returns the number of the pattern found, -1 if timed out
+int Stream::findMulti(StreamMatcher &matcher)
+{
+  int c, found;
+
+  while( (c = timedRead()) >= 0){
+    if ((found = matcher.match((char)c)) >= 0)
+      return found;
   }
-  return false;
+  return -1;
 }
 
 
@@ -218,10 +240,9 @@ size_t Stream::readBytes(char *buffer, size_t length)
 {
   size_t count = 0;
   while (count < length) {
-    int c = timedRead();
-    if (c < 0) break;
-    *buffer++ = (char)c;
-    count++;
+    int n = timedRead((uint8_t *)buffer + count, length - count);
+    if (n <= 0) break;
+    count += n;
   }
   return count;
 }
@@ -247,11 +268,14 @@ size_t Stream::readBytesUntil(char terminator, char *buffer, size_t length)
 String Stream::readString()
 {
   String ret;
-  int c = timedRead();
-  while (c >= 0)
+  char buffer[READ_CHUNK];
+  int n = available();
+  if (n > 0)
+    ret.reserve(n);
+  while ((n = timedRead((uint8_t *)buffer, sizeof(buffer))) > 0)
   {
-    ret += (char)c;
-    c = timedRead();
+    if (!ret.concat(buffer, n))
+      break;
   }
   return ret;
 }
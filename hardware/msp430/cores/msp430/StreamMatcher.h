@@ -0,0 +1,90 @@
+/*
+  StreamMatcher.h - Watches a stream of characters for several patterns
+  at once, used by Stream::find() and findUntil()
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef StreamMatcher_h
+#define StreamMatcher_h
+
+#include <stddef.h>
+#include <string.h>
+
+// Most patterns a matcher watches at once
+#ifndef STREAM_MATCH_TARGETS
+#define STREAM_MATCH_TARGETS  4
+#endif
+
+// Bytes shared by the patterns' fallback tables, one per pattern byte.
+// A pattern that no longer fits (or is over 256 bytes long) is still
+// matched, but works out its fallbacks on each mismatch.
+#ifndef STREAM_MATCH_POOL
+#define STREAM_MATCH_POOL     32
+#endif
+
+/*
+ * Each pattern is followed with a Knuth-Morris-Pratt automaton, so every
+ * character is looked at once and overlapping starts ("aab" in "aaab")
+ * are not missed. The patterns are not copied and must stay valid while
+ * the matcher is in use.
+ *
+ *   StreamMatcher m;
+ *   m.add("Content-Length: ");
+ *   m.add("\r\n\r\n");
+ *   switch (client.findMulti(m)) { ... }
+ */
+class StreamMatcher
+{
+  public:
+    StreamMatcher() : count(0), used(0) {}
+
+    // watch for pattern, returns false if the matcher is full or the
+    // pattern is empty. Patterns are numbered from 0 in the order added.
+    bool add(const char *pattern, size_t length);
+    bool add(const char *pattern) { return add(pattern, strlen(pattern)); }
+
+    // forget any partial matches
+    void reset();
+
+    // feed one character, returns the number of the pattern it completes
+    // or -1. When several complete at once the lowest number wins. After
+    // a match all patterns start over.
+    int match(char c);
+
+    // feed buffer until a pattern completes, returns its number or -1.
+    // *consumed (if given) is set to the bytes fed, up to and including
+    // the last byte of the match.
+    int match(const char *buffer, size_t length, size_t *consumed = NULL);
+
+    int targets() const { return count; }
+
+  private:
+    struct Target {
+      const char *str;
+      size_t len;
+      size_t state;          // pattern bytes matched so far
+      unsigned char *fail;   // longest proper border of each prefix, or NULL
+    };
+
+    size_t border(const Target &t, size_t q);
+
+    Target target[STREAM_MATCH_TARGETS];
+    unsigned char pool[STREAM_MATCH_POOL];
+    unsigned char count;
+    size_t used;
+};
+
+#endif
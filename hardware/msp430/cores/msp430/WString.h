@@ -33,6 +33,26 @@
 //     -felide-constructors
 //     -std=c++0x
 
+// Strings of up to STRING_SSO_SIZE - 1 characters are kept in the String
+// object itself and need no heap block (1 keeps only "" inline).  The
+// result of a chain of + is built in a STRING_SUM_SIZE buffer inside the
+// temporary, so the String it ends up in allocates its final length once.
+// Both change the layout of String: set them for the whole build with
+// -D in the compiler flags, never with a #define in a sketch, or the core
+// and the sketch disagree about what a String is.
+#ifndef STRING_SSO_SIZE
+#define STRING_SSO_SIZE 8
+#endif
+#ifndef STRING_SUM_SIZE
+#define STRING_SUM_SIZE 32
+#endif
+#if STRING_SSO_SIZE < 1
+#error STRING_SSO_SIZE must be at least 1
+#endif
+#if STRING_SUM_SIZE < STRING_SSO_SIZE
+#error STRING_SUM_SIZE must be at least STRING_SSO_SIZE
+#endif
+
 class __FlashStringHelper;
 //#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(PSTR(string_literal)))
 #define F(string_literal) (string_literal)
@@ -69,6 +89,8 @@ public:
 	explicit String(unsigned int, unsigned char base=10);
 	explicit String(long, unsigned char base=10);
 	explicit String(unsigned long, unsigned char base=10);
+	explicit String(float, unsigned char decimalPlaces=2);
+	explicit String(double, unsigned char decimalPlaces=2);
 	~String(void);
 
 	// memory management
@@ -95,6 +117,7 @@ public:
 	// concatenation is considered unsucessful.  
 	unsigned char concat(const String &str);
 	unsigned char concat(const char *cstr);
+	unsigned char concat(const char *cstr, unsigned int length);
 	unsigned char concat(char c);
 	unsigned char concat(unsigned char c);
 	unsigned char concat(int num);
@@ -175,12 +198,14 @@ protected:
 	char *buffer;	        // the actual char array
 	unsigned int capacity;  // the array length minus one (for the '\0')
 	unsigned int len;       // the String length (not counting the '\0')
-	unsigned char flags;    // unused, for future features
+	unsigned char flags;    // STRING_INLINE when buffer is not a heap block
+	char sso[STRING_SSO_SIZE]; // inline storage for short strings
+	enum {STRING_INLINE = 1};
 protected:
 	void init(void);
 	void invalidate(void);
 	unsigned char changeBuffer(unsigned int maxStrLen);
-	unsigned char concat(const char *cstr, unsigned int length);
+	unsigned char grow(unsigned int size);
 
 	// copy and move
 	String & copy(const char *cstr, unsigned int length);
@@ -192,14 +217,18 @@ protected:
 class StringSumHelper : public String
 {
 public:
-	StringSumHelper(const String &s) : String(s) {}
-	StringSumHelper(const char *p) : String(p) {}
-	StringSumHelper(char c) : String(c) {}
-	StringSumHelper(unsigned char num) : String(num) {}
-	StringSumHelper(int num) : String(num) {}
-	StringSumHelper(unsigned int num) : String(num) {}
-	StringSumHelper(long num) : String(num) {}
-	StringSumHelper(unsigned long num) : String(num) {}
+	StringSumHelper(const String &s) {start(); if (!concat(s)) invalidate();}
+	StringSumHelper(const char *p) {start(); if (!concat(p)) invalidate();}
+	StringSumHelper(char c) {start(); concat(c);}
+	StringSumHelper(unsigned char num) {start(); concat(num);}
+	StringSumHelper(int num) {start(); concat(num);}
+	StringSumHelper(unsigned int num) {start(); concat(num);}
+	StringSumHelper(long num) {start(); concat(num);}
+	StringSumHelper(unsigned long num) {start(); concat(num);}
+private:
+	// build in sum until the result outgrows it
+	void start(void) {buffer = sum; capacity = STRING_SUM_SIZE - 1; len = 0; flags |= STRING_INLINE; sum[0] = 0;}
+	char sum[STRING_SUM_SIZE];
 };
 
 #endif  // __cplusplus
@@ -0,0 +1,131 @@
+/*
+  cotask.h - Cooperative tasks that wait without blocking, run from the main
+  loop and from delay()
+
+  Energia.h does not include it, so the names stay out of sketches that
+  do not use it: #include "cotask.h" to get them.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _COTASK_
+#define _COTASK_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif // __cplusplus
+
+struct CoTask;
+
+// What a task function returns: still waiting, or finished
+#define COTASK_WAITING    0
+#define COTASK_DONE       1
+
+typedef uint8_t (*CoTaskFunction)(struct CoTask *task);
+
+/*
+ * The caller owns the storage; a task must stay valid (e.g. static or a
+ * class member) while it is started. arg is free for the task function,
+ * the other fields are private.
+ */
+typedef struct CoTask {
+	struct CoTask *next;            // in the list coTaskRun() goes through
+	CoTaskFunction function;
+	void *arg;
+	unsigned int resume;          // line to continue at, 0 to start over
+	uint8_t flags;
+	unsigned long wake;           // millis() the current wait ends at
+} CoTask;
+
+/*
+ * A task function runs from COTASK_BEGIN to the first wait that is not
+ * satisfied and returns; the next call continues from that wait. Tasks
+ * have no stack of their own: local variables are lost across waits (keep
+ * state in arg or statics), waits can only be in the task function itself,
+ * not inside a switch statement and no more than one on a line.
+ *
+ *   uint8_t blink(CoTask *task)
+ *   {
+ *       COTASK_BEGIN(task);
+ *       for (;;) {
+ *           digitalWrite(RED_LED, !digitalRead(RED_LED));
+ *           COTASK_SLEEP(task, 500);
+ *       }
+ *       COTASK_END(task);
+ *   }
+ */
+#define COTASK_BEGIN(task)        switch ((task)->resume) { case 0:
+
+#define COTASK_END(task)          } (task)->resume = 0; return COTASK_DONE
+
+// Lets the other tasks run, continues on the next pass
+#define COTASK_YIELD(task)                                                  \
+	do {                                                                    \
+		(task)->resume = __LINE__;                                          \
+		return COTASK_WAITING;                                              \
+		case __LINE__:;                                                     \
+	} while (0)
+
+// Continues once cond is true, testing it on every pass
+#define COTASK_AWAIT(task, cond)                                            \
+	do {                                                                    \
+		(task)->resume = __LINE__;                                          \
+		case __LINE__:                                                      \
+		if (!(cond))                                                        \
+			return COTASK_WAITING;                                          \
+	} while (0)
+
+// Continues after ms milliseconds; the task is not called in between
+#define COTASK_SLEEP(task, ms)                                              \
+	do {                                                                    \
+		coTaskSleep((task), (ms));                                          \
+		COTASK_YIELD(task);                                                 \
+	} while (0)
+
+// Continues once cond is true or after ms milliseconds, whichever is first;
+// coTaskTimedOut() tells which when cond can have changed since
+#define COTASK_AWAIT_TIMEOUT(task, cond, ms)                                \
+	do {                                                                    \
+		coTaskTimeout((task), (ms));                                        \
+		COTASK_AWAIT(task, (cond) || coTaskTimedOut(task));                 \
+	} while (0)
+
+/*
+ * Tasks run in the main loop, between loop() and the next one, and while
+ * delay() waits, so a sketch or library that delays does not hold the
+ * others up. A task that calls delay() does hold them up: tasks are not
+ * run again while one is running. None of these may be called from
+ * interrupts. Starting a started task restarts it from the beginning.
+ */
+void coTaskStart(CoTask *task, CoTaskFunction function, void *arg);
+void coTaskStop(CoTask *task);
+bool coTaskActive(const CoTask *task);
+
+// Used by the wait macros
+void coTaskSleep(CoTask *task, unsigned long ms);
+void coTaskTimeout(CoTask *task, unsigned long ms);
+bool coTaskTimedOut(const CoTask *task);
+
+// Calls each started task once, returns at once if tasks are running
+void coTaskRun(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // __cplusplus
+
+#endif // _COTASK_
@@ -0,0 +1,39 @@
+/*
+  dma_isr_handler.c - The shared DMA interrupt of the msp430 parts with a
+  DMA controller, handed out to Serial and the analog block sampling
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "Energia.h"
+#include "dma_isr_handler.h"
+#ifdef DMA_ISR_AVAILABLE
+/* Called by every module that enables a DMA interrupt, so that the linker
+ * keeps DMA_VECTOR. */
+void dma_isr_install(){}
+
+__attribute__((interrupt(DMA_VECTOR)))
+void DMA_ISR(void)
+{
+	switch (DMAIV) {
+		case DMAIV_DMA0IFG: uart_dma_rx_isr(); break;
+		case DMAIV_DMA1IFG: uart_dma_tx_isr(); break;
+		case DMAIV_DMA2IFG:
+			if (adc_dma_isr())
+				__bic_SR_register_on_exit(CPUOFF);
+			break;
+	}
+}
+#endif
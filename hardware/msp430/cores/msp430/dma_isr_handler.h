@@ -0,0 +1,38 @@
+/*
+  dma_isr_handler.h - The modules served by the shared DMA interrupt
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef dma_isr_handler_h
+#define dma_isr_handler_h
+
+/* The DMA channels share one vector. Channels 0 and 1 belong to Serial in
+ * DMA mode, channel 2 to the block sampling of wiring_analog.c. */
+#if defined(__MSP430_HAS_DMAX_3__) && (defined(__MSP430F5529__) || defined(__MSP430FR5969__))
+#define DMA_ISR_AVAILABLE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+void uart_dma_rx_isr(void);
+void uart_dma_tx_isr(void);
+uint8_t adc_dma_isr(void);      /* nonzero to wake the CPU */
+void dma_isr_install(void);
+#ifdef __cplusplus
+}
+#endif
+#endif
+#endif /* dma_isr_handler_h */
@@ -1,4 +1,5 @@
 #include <Energia.h>
+#include "cotask.h"
 
 int main(void)
 {
@@ -9,6 +10,7 @@ int main(void)
 	for (;;) {
 		loop();
 		if (serialEventRun) serialEventRun();
+		coTaskRun();
 	}
 
 	return 0;
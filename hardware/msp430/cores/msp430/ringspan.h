@@ -0,0 +1,44 @@
+/*
+  ringspan.h - Contiguous spans of the HardwareSerial rings, kept free of
+  hardware so that hardware/tools/tests can check them on the host
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _RINGSPAN_
+#define _RINGSPAN_
+
+/*
+ * read and write are positions in a ring of size bytes that keeps one slot
+ * empty to tell a full ring from an empty one. Each returns how many bytes
+ * can be taken from read, or stored at write, without wrapping.
+ */
+static inline unsigned long ringReadSpan(unsigned long read, unsigned long write,
+	unsigned long size)
+{
+	/* Up to the write position, or to the end of the ring if it wrapped */
+	return (write >= read) ? (write - read) : (size - read);
+}
+
+static inline unsigned long ringWriteSpan(unsigned long read, unsigned long write,
+	unsigned long size)
+{
+	if (write >= read)
+		return size - write - (read == 0 ? 1 : 0);
+
+	return read - write - 1;
+}
+
+#endif /* _RINGSPAN_ */
@@ -29,6 +29,7 @@
   Boston, MA  02111-1307  USA
 */
 #include "Energia.h"
+#include "cotask.h"
 
 // the clock source is set so that watch dog timer (WDT) ticks every clock
 // cycle (F_CPU), and the watch dog timer ISR is called every 512 ticks
@@ -63,6 +64,44 @@ volatile uint16_t vlo_freq = 0;
 void initClocks(void);
 void enableWatchDogIntervalMode(void);
 
+// Build with TIMEBASE_TIMER_A set to a Timer_A number (e.g. -DTIMEBASE_TIMER_A=1)
+// to give micros() 1 us resolution. That timer then runs free from SMCLK,
+// divided to 1 or 2 ticks per microsecond, and is read between its
+// overflows; analogWrite() only switches its pins on or off. Timer0_A
+// cannot be chosen, tone(), Servo and TimerSerial need it and its
+// interrupt. Without it micros() counts WDT overflows and leaves all
+// timers free. millis(), delay() and sleep() use the WDT either way.
+// micros() stops in LPM3/LPM4 with the Timer_A, as SMCLK is off there.
+#ifdef TIMEBASE_TIMER_A
+#if TIMEBASE_TIMER_A == 0
+#error "TIMEBASE_TIMER_A: Timer0_A belongs to tone(), Servo and TimerSerial, use another Timer_A"
+#endif
+#define TIMEBASE_REG_(n, r)     TA##n##r
+#define TIMEBASE_REG(n, r)      TIMEBASE_REG_(n, r)
+#define TIMEBASE_VECTOR_(n)     TIMER##n##_A1_VECTOR
+#define TIMEBASE_VECTOR(n)      TIMEBASE_VECTOR_(n)
+#define TIMEBASE_CTL            TIMEBASE_REG(TIMEBASE_TIMER_A, CTL)
+#define TIMEBASE_R              TIMEBASE_REG(TIMEBASE_TIMER_A, R)
+#define TIMEBASE_IV             TIMEBASE_REG(TIMEBASE_TIMER_A, IV)
+
+#if F_CPU == 1000000L || F_CPU == 2000000L
+#define TIMEBASE_DIV            ID_0
+#define TIMEBASE_SHIFT          (F_CPU / 2000000L)
+#elif F_CPU == 8000000L || F_CPU == 16000000L
+#define TIMEBASE_DIV            ID_3
+#define TIMEBASE_SHIFT          (F_CPU / 16000000L)
+#else
+#error "TIMEBASE_TIMER_A needs F_CPU of 1, 2, 8 or 16 MHz"
+#endif
+
+volatile unsigned long timebase_overflow_count = 0;
+
+static void enableTimebase(void)
+{
+	TIMEBASE_CTL = TASSEL_2 | TIMEBASE_DIV | MC_2 | TACLR | TAIE;
+}
+#endif
+
 void enableXtal()
 {
 #if (defined(__MSP430_HAS_CS__) || defined(__MSP430_HAS_CS_A__))
@@ -166,6 +205,9 @@ void init()
         disableWatchDog();
 	initClocks();
         enableWatchDogIntervalMode();
+#ifdef TIMEBASE_TIMER_A
+	enableTimebase();
+#endif
 
 #ifdef __MSP430_HAS_USB__
 	/* Enable access to USB registers */
@@ -368,12 +410,28 @@ void initClocks(void)
 unsigned long micros()
 {
 	unsigned long m;
+#ifdef TIMEBASE_TIMER_A
+	unsigned int t;
+#endif
 
 	// disable interrupts to ensure consistent readings
 	// safe SREG to avoid issues if interrupts were already disabled
 	uint16_t oldSREG = READ_SR;
 	__dint();
 
+#ifdef TIMEBASE_TIMER_A
+	m = timebase_overflow_count;
+	t = TIMEBASE_R;
+	// an overflow the interrupt has not counted yet leaves a small count
+	if ((TIMEBASE_CTL & TAIFG) && t < 0x8000)
+		m++;
+
+	WRITE_SR(oldSREG);	// safe to enable interrupts again
+
+	// overflows are 65536 ticks of 2^TIMEBASE_SHIFT per microsecond; shifting
+	// the parts separately keeps the result exact as it wraps around
+	return (m << (16 - TIMEBASE_SHIFT)) + (t >> TIMEBASE_SHIFT);
+#else
 	m = wdt_overflow_count;
 
 	WRITE_SR(oldSREG);	// safe to enable interrupts again
@@ -385,6 +443,7 @@ unsigned long micros()
 	// for example +/-256us @1MHz and +/-16us @16MHz
 
 	return (m * MICROSECONDS_PER_WDT_OVERFLOW);
+#endif
 }
 
 unsigned long millis()
@@ -567,11 +626,18 @@ void suspend(void)
 void delay(uint32_t milliseconds)
 {
 	uint32_t start = micros();
+	// GIE is clear in an interrupt handler, which may have interrupted
+	// one of the tasks; the LPM0 below sets it, so look now
+	uint16_t tasks = READ_SR & GIE;
+
 	while(milliseconds > 0) {
 		if ((micros() - start) >= 1000) {
 			milliseconds--;
 			start += 1000;
 		}
+		// Tasks run on every wakeup, at least once per WDT interval
+		if (tasks)
+			coTaskRun();
 		__bis_status_register(LPM0_bits+GIE);
 	}
 }
@@ -598,3 +664,13 @@ void watchdog_isr (void)
         /* Exit from LMP3 on reti (this includes LMP0) */
         __bic_status_register_on_exit(LPM3_bits);
 }
+
+#ifdef TIMEBASE_TIMER_A
+__attribute__((interrupt(TIMEBASE_VECTOR(TIMEBASE_TIMER_A))))
+void timebase_isr(void)
+{
+	// reading the vector clears the overflow flag
+	if (TIMEBASE_IV == TA0IV_TAIFG)
+		timebase_overflow_count++;
+}
+#endif
@@ -31,6 +31,7 @@
 
 #include "wiring_private.h"
 #include "pins_energia.h"
+#include "dma_isr_handler.h"
 
 #if defined(__MSP430_HAS_ADC10__) && !defined(ADC10ENC)
 #define ADC10ENC ENC 
@@ -67,6 +68,51 @@ void analogReference(uint16_t mode)
 	// there's something connected to AREF.
 	analog_reference = mode;
 }
+
+#define ANALOG_COLD 0xFFFF
+static uint8_t analog_hold;
+static uint16_t analog_warm = ANALOG_COLD;  // reference the ADC is held on with
+
+static void analogPowerDown(void)
+{
+#if defined(__MSP430_HAS_ADC10__)
+	ADC10CTL0 &= ~ADC10ENC;
+	ADC10CTL0 &= ~(ADC10ON | REFON);
+#endif
+#if defined(__MSP430_HAS_ADC10_B__)
+	ADC10CTL0 &= ~ADC10ENC;
+	ADC10CTL0 &= ~(ADC10ON);
+	REFCTL0 &= ~REFON;
+#endif
+#if defined(__MSP430_HAS_ADC12_PLUS__) || defined(__MSP430_HAS_ADC12_B__)
+	ADC12CTL0 &= ~ADC12ENC;
+	ADC12CTL0 &= ~(ADC12ON);
+	REFCTL0 &= ~REFON;
+#endif
+	analog_warm = ANALOG_COLD;
+}
+
+/* True if the ADC was left on with this reference, which then needs no
+ * time to settle. Remembers ref for the next call while holding. */
+static uint8_t analogWarm(uint16_t ref)
+{
+	uint8_t warm = analog_warm == ref;
+
+	analog_warm = analog_hold ? ref : ANALOG_COLD;
+	return warm;
+}
+
+static volatile uint8_t block_running;
+
+/* With hold set the ADC and the reference stay on after a conversion, so
+ * the next analogRead() or block skips the power up and the reference
+ * settling time. Costs the reference current (~250 uA) while idle. */
+void analogReferenceHold(boolean hold)
+{
+	analog_hold = hold;
+	if (!hold && !block_running)
+		analogPowerDown();
+}
 #endif
 
 
@@ -105,6 +151,20 @@ void analogResolution(uint16_t res)
 }
 
 
+#ifdef TIMEBASE_TIMER_A
+/* True for the pins of the Timer_A that runs micros(), see wiring.c */
+static uint8_t timebasePin(uint8_t timer)
+{
+#if TIMEBASE_TIMER_A == 1
+	return timer >= T1A0 && timer <= T1A5;
+#elif TIMEBASE_TIMER_A == 2
+	return timer >= T2A0 && timer <= T2A2;
+#else
+	return 0;
+#endif
+}
+#endif
+
 //Arduino specifies ~490 Hz for analog out PWM so we follow suit.
 #define PWM_PERIOD analog_period // F_CPU/490
 #define PWM_DUTY(x) ( (unsigned long)x*PWM_PERIOD / (unsigned long)analog_res )
@@ -130,6 +190,13 @@ void analogWrite(uint8_t pin, int val)
 	        volatile uint8_t *sel;
                 
                 if (port == NOT_A_PORT) return; // pin on timer?
+#ifdef TIMEBASE_TIMER_A
+		// the timebase timer must keep running free: no PWM on its pins
+		if (timebasePin(digitalPinToTimer(pin))) {
+			digitalWrite(pin, val <= (analog_res >> 1) ? LOW : HIGH);
+			return;
+		}
+#endif
                
 	        sel = portSelRegister(port); // get the port function select register address
 		*sel |= bit;                 // set bit in pin function select register  
@@ -288,6 +355,13 @@ uint16_t analogRead(uint8_t pin)
 	else
 		channel = digitalPinToADCIn(pin);
 
+	// A running block owns the ADC: wait for it, unless its end can't be seen
+#if defined(__MSP430_HAS_ADC10__) || defined(__MSP430_HAS_ADC10_B__) || defined(__MSP430_HAS_ADC12_PLUS__) || defined(__MSP430_HAS_ADC12_B__)
+	while (block_running)
+		if (!(READ_SR & GIE))
+			return 0;
+#endif
+
 	// Check if pin is valid
 	if (pin==NOT_ON_ADC)
 		return 0;
@@ -316,13 +390,15 @@ uint16_t analogRead(uint8_t pin)
             ADC10ON | ADC10SHT_3 | ADC10IE; // turn ADC ON; sample + hold @ 64 × ADC10CLKs; Enable interrupts
     ADC10CTL1 |= (channel << 12);               // select channel
     ADC10AE0 = (1 << channel);                  // Disable input/output buffer on pin
-    __delay_cycles(128);                    // Delay to allow Ref to settle
+    if (!analogWarm(analog_reference))
+        __delay_cycles(128);                // Delay to allow Ref to settle
     ADC10CTL0 |= ADC10ENC | ADC10SC;        // enable ADC and start conversion
     while (ADC10CTL1 & ADC10BUSY) {         // sleep and wait for completion
         __bis_SR_register(CPUOFF + GIE);    // LPM0 with interrupts enabled
     }
     /* POWER: Turn ADC and reference voltage off to conserve power */
-    ADC10CTL0 &= ~(ADC10ON | REFON);
+    if (!analog_hold)
+        analogPowerDown();
 #endif
 #if defined(__MSP430_HAS_ADC10_B__)
     ADC10CTL0 &= ~ADC10ENC;                 // disable ADC
@@ -335,14 +411,15 @@ uint16_t analogRead(uint8_t pin)
     ADC10CTL2 |= ADC10RES;                  // 10-bit resolution
     ADC10IFG = 0;                           // Clear Flags
     ADC10IE |= ADC10IE0;                    // Enable interrupts
-    __delay_cycles(128);                    // Delay to allow Ref to settle
+    if (!analogWarm(analog_reference))
+        __delay_cycles(128);                // Delay to allow Ref to settle
     ADC10CTL0 |= ADC10ENC | ADC10SC;        // enable ADC and start conversion
     while (ADC10CTL1 & ADC10BUSY) {         // sleep and wait for completion
         __bis_SR_register(CPUOFF + GIE);    // LPM0 with interrupts enabled
     }
     /* POWER: Turn ADC and reference voltage off to conserve power */
-    ADC10CTL0 &= ~(ADC10ON);
-    REFCTL0 &= ~REFON;
+    if (!analog_hold)
+        analogPowerDown();
 #endif
 #if defined(__MSP430_HAS_ADC12_PLUS__)
     ADC12CTL0 &= ~ADC12ENC;                 // disable ADC
@@ -360,14 +437,15 @@ uint16_t analogRead(uint8_t pin)
     ADC12CTL2 |= ADC12RES1;                 // 12-bit resolution
     ADC12IFG = 0;                           // Clear Flags
     ADC12IE |= ADC12IE0;                    // Enable interrupts
-    __delay_cycles(128);                    // Delay to allow Ref to settle
+    if (!analogWarm(pin == TEMPSENSOR ? INTERNAL1V5 : analog_reference))
+        __delay_cycles(128);                // Delay to allow Ref to settle
     ADC12CTL0 |= ADC12ENC | ADC12SC;        // enable ADC and start conversion
     while (ADC12CTL1 & ADC12BUSY) {         // sleep and wait for completion
         __bis_SR_register(CPUOFF + GIE);    // LPM0 with interrupts enabled
     }
     /* POWER: Turn ADC and reference voltage off to conserve power */
-    ADC12CTL0 &= ~(ADC12ON);
-    REFCTL0 &= ~REFON;
+    if (!analog_hold)
+        analogPowerDown();
 #endif
 #if defined(__MSP430_HAS_ADC12_B__)
     ADC12CTL0 &= ~ADC12ENC;                 // disable ADC
@@ -386,6 +464,7 @@ uint16_t analogRead(uint8_t pin)
       REFCTL0 = (analog_reference & REF_MASK); // Set reference using masking off the SREF bits. See Energia.h.
       ADC12MCTL0 = channel | (analog_reference & REFV_MASK); // set channel and reference 
 	}
+    analogWarm(channel == TEMPSENSOR ? INTERNAL1V2 : analog_reference);
     if (REFCTL0 & REFON)
 	  while(!(REFCTL0 & REFGENRDY));        // wait till ref generator ready
     ADC12CTL0 |= ADC12ENC | ADC12SC;        // enable ADC and start conversion
@@ -393,8 +472,8 @@ uint16_t analogRead(uint8_t pin)
         __bis_SR_register(CPUOFF + GIE);    // LPM0 with interrupts enabled
     }
     /* POWER: Turn ADC and reference voltage off to conserve power */
-    ADC12CTL0 &= ~(ADC12ON);
-    REFCTL0 &= ~(REFON);
+    if (!analog_hold)
+        analogPowerDown();
 #endif
     return ADCxMEM0;  // return sampled value after returning to active mode in ADC10_ISR
 #else
@@ -403,10 +482,304 @@ uint16_t analogRead(uint8_t pin)
 #endif
 }
 
+/*
+ * Block sampling: the ADC runs in a repeat mode and the ADC10 data transfer
+ * controller, or DMA channel 2 for the ADC12, stores the results, so the CPU
+ * only sees the end of the block. Results are interleaved pin by pin.
+ *
+ * With a rate, the TA0.1 output of Timer0_A starts every conversion, so the
+ * pins of one round are 1 / (rate * count) apart; analogWrite() on the
+ * Timer0_A pins is put aside meanwhile and carries on when the block ends.
+ * Rate 0 converts back to back at the pace of the ADC.
+ *
+ * analogRead() waits for a running block, or returns 0 when called with
+ * interrupts disabled.
+ */
+#if defined(__MSP430_HAS_ADC10__) || \
+    ((defined(__MSP430_HAS_ADC12_PLUS__) || defined(__MSP430_HAS_ADC12_B__)) && defined(DMA_ISR_AVAILABLE))
+#define ANALOG_BLOCK
+#endif
+
+#ifdef ANALOG_BLOCK
+#define ANALOG_BLOCK_MAX_PINS 8
+#define ANALOG_BLOCK_MAX_RATE 50000         // conversions per second
+
+#if defined(__MSP430FR5969__)
+#define DMA_TRIGGER_ADC12 26
+#else
+#define DMA_TRIGGER_ADC12 24
+#endif
+
+static uint16_t *block_next;                // ADC12 rounds: where the DMA stores next
+static uint16_t *block_end;
+static uint8_t block_count;
+static uint32_t block_rate;
+static uint8_t block_timer;                 // Timer0_A taken, block_ta0 holds its PWM
+static uint16_t block_ta0[4];               // TA0CTL, TA0CCR0, TA0CCTL1, TA0CCR1
+
+static uint8_t blockChannel(uint8_t pin)
+{
+	if (pin >= 128)
+		return pin - 128;
+	return digitalPinToADCIn(pin);
+}
+
+static uint8_t blockTimerStart(uint32_t conversions)
+{
+	uint32_t period = F_CPU / conversions;
+	uint16_t div = ID_0;
+
+	if (period > 0xFFFF) {
+		period >>= 3;
+		div = ID_3;
+	}
+	if (period > 0xFFFF || period < 2)
+		return 0;
+
+	block_ta0[0] = TA0CTL;
+	block_ta0[1] = TA0CCR0;
+	block_ta0[2] = TA0CCTL1;
+	block_ta0[3] = TA0CCR1;
+	block_timer = 1;
+
+	TA0CTL = TACLR;
+	TA0CCR0 = period - 1;
+	TA0CCR1 = period >> 1;
+	TA0CCTL1 = OUTMOD_7;                    // rising edge of TA0.1 at each wrap
+	TA0CTL = TASSEL_2 | MC_1 | div;         // SMCLK, up mode
+	return 1;
+}
+
+/* Stops the conversions at once and releases the ADC for analogRead().
+ * Called with interrupts disabled or from an interrupt. */
+static void blockFinish(void)
+{
+	if (block_timer) {
+		TA0CTL = 0;                         // back to the analogWrite() settings
+		TA0CCR0 = block_ta0[1];
+		TA0CCR1 = block_ta0[3];
+		TA0CCTL1 = block_ta0[2];
+		TA0CTL = block_ta0[0];
+		block_timer = 0;
+	}
+#if defined(__MSP430_HAS_ADC10__)
+	ADC10CTL1 &= ~CONSEQ_3;
+	ADC10CTL0 &= ~ADC10ENC;
+	ADC10DTC1 = 0;                          // transfer controller off
+#else
+	ADC12CTL1 &= ~ADC12CONSEQ_3;
+	ADC12CTL0 &= ~ADC12ENC;
+	DMA2CTL = 0;
+#endif
+	if (!analog_hold)
+		analogPowerDown();
+	block_running = 0;
+}
+
+#if !defined(__MSP430_HAS_ADC10__)
+/* A block of one pin is a single DMA transfer. With more pins the DMA moves
+ * one round from ADC12MEM0.. per end of sequence and is pointed at the next
+ * round here. */
+uint8_t adc_dma_isr(void)
+{
+	if (!block_running)
+		return 0;
+
+	if (block_count > 1) {
+		block_next += block_count;
+		if (block_next < block_end) {
+			DMA2DA = (unsigned int)block_next;
+			DMA2CTL |= DMAEN;
+			if (!block_rate)
+				ADC12CTL0 |= ADC12SC;       // single sequence mode, start the next one
+			return 0;
+		}
+	}
+
+	blockFinish();
+	return 1;
+}
+#endif
+
+boolean analogReadBlockStart(const uint8_t *pins, uint8_t count, uint16_t *buffer, uint16_t samples, uint32_t rate)
+{
+	uint8_t channels[ANALOG_BLOCK_MAX_PINS];
+	uint8_t i;
+#if defined(__MSP430_HAS_ADC10__)
+	uint8_t enable = 0;
+#else
+	uint16_t conseq;
+#endif
+
+	if (count == 0 || count > ANALOG_BLOCK_MAX_PINS || !buffer ||
+	    samples < count || samples % count || rate > ANALOG_BLOCK_MAX_RATE / count)
+		return false;
+#if defined(__MSP430_HAS_ADC10__)
+	/* The ADC10 runs a sequence from its first channel down to A0 and the
+	 * transfer controller counts 8 bits. */
+	if (samples > 255)
+		return false;
+#endif
+
+	for (i = 0; i < count; i++) {
+		channels[i] = blockChannel(pins[i]);
+		if (channels[i] == NOT_ON_ADC)
+			return false;
+#if defined(__MSP430_HAS_ADC10__)
+		if (count > 1 && channels[i] != count - 1 - i)
+			return false;
+		if (channels[i] < 8)
+			enable |= 1 << channels[i];
+#endif
+	}
+
+	analogReadBlockStop();
+
+	block_next = buffer;
+	block_end = buffer + samples;
+	block_count = count;
+	block_rate = rate;
+
+#if defined(__MSP430_HAS_ADC10__)
+	ADC10CTL0 &= ~ADC10ENC;
+	ADC10CTL1 = ADC10SSEL_0 | ADC10DIV_1 | (channels[0] << 12) |
+		(count > 1 ? CONSEQ_3 : CONSEQ_2) | (rate ? SHS_1 : SHS_0);
+	ADC10CTL0 = analog_reference | ADC10ON | ADC10SHT_1 | ADC10IE | (rate ? 0 : MSC);
+	ADC10AE0 = enable;
+	ADC10DTC0 = 0;                          // one block, then ADC10IFG
+	ADC10DTC1 = samples;
+	ADC10SA = (unsigned int)buffer;
+	if (!analogWarm(analog_reference))
+		__delay_cycles(128);
+	block_running = 1;
+	ADC10CTL0 |= ADC10ENC | (rate ? 0 : ADC10SC);
+#else
+	ADC12CTL0 &= ~ADC12ENC;
+	while(REFCTL0 & REFGENBUSY);
+	REFCTL0 = (analog_reference & REF_MASK);
+	for (i = 0; i < count; i++) {
+#if defined(__MSP430_HAS_ADC12_PLUS__)
+		(&ADC12MCTL0)[i] = channels[i] | ((analog_reference >> 4) & REFV_MASK) |
+			(i == count - 1 ? ADC12EOS : 0);
+#else
+		(&ADC12MCTL0)[i] = channels[i] | (analog_reference & REFV_MASK) |
+			(i == count - 1 ? ADC12EOS : 0);
+#endif
+	}
+
+	/* Timed rounds repeat on the timer edges; back to back rounds of
+	 * several pins run one sequence at a time, so that the DMA is ready
+	 * for the next round before it ends. */
+	if (count == 1)
+		conseq = ADC12CONSEQ_2;
+	else
+		conseq = rate ? ADC12CONSEQ_3 : ADC12CONSEQ_1;
+	ADC12CTL0 = ADC12ON | ADC12SHT0_1 | (rate ? 0 : ADC12MSC);
+	ADC12CTL1 = ADC12SSEL_0 | ADC12DIV_1 | ADC12SHP | conseq | (rate ? ADC12SHS_1 : ADC12SHS_0);
+	ADC12CTL2 |= ADC12RES_2;                // 12-bit resolution
+#if defined(__MSP430_HAS_ADC12_PLUS__)
+	ADC12IE = 0;                            // the DMA takes the results
+	ADC12IFG = 0;
+#else
+	ADC12CTL3 = ADC12TCMAP | ADC12BATMAP;
+	ADC12IER0 = 0;
+	ADC12IFGR0 = 0;
+#endif
+
+	dma_isr_install();
+	DMACTL4 = DMARMWDIS;
+	DMACTL1 = (DMACTL1 & 0xFF00) | DMA_TRIGGER_ADC12;
+	DMA2CTL = 0;
+	DMA2SA = (unsigned int)&ADC12MEM0;
+	DMA2DA = (unsigned int)buffer;
+	if (count > 1) {
+		DMA2SZ = count;
+		DMA2CTL = DMADT_1 | DMASRCINCR_3 | DMADSTINCR_3 | DMAIE | DMAEN;
+	} else {
+		DMA2SZ = samples;
+		DMA2CTL = DMADT_0 | DMASRCINCR_0 | DMADSTINCR_3 | DMAIE | DMAEN;
+	}
+
+#if defined(__MSP430_HAS_ADC12_PLUS__)
+	if (!analogWarm(analog_reference))
+		__delay_cycles(128);
+#else
+	analogWarm(analog_reference);
+	if (REFCTL0 & REFON)
+		while(!(REFCTL0 & REFGENRDY));
+#endif
+	block_running = 1;
+	ADC12CTL0 |= ADC12ENC | (rate ? 0 : ADC12SC);
+#endif
+
+	if (rate && !blockTimerStart(rate * count)) {
+		analogReadBlockStop();
+		return false;
+	}
+	return true;
+}
+
+boolean analogReadBlockDone(void)
+{
+	return !block_running;
+}
+
+void analogReadBlockStop(void)
+{
+	uint16_t oldSREG = READ_SR;
+	__dint();
+
+	if (block_running)
+		blockFinish();
+
+	WRITE_SR(oldSREG);
+}
+
+boolean analogReadBlock(const uint8_t *pins, uint8_t count, uint16_t *buffer, uint16_t samples, uint32_t rate)
+{
+	uint16_t oldSREG;
+
+	if (!analogReadBlockStart(pins, count, buffer, samples, rate))
+		return false;
+
+	/* Sleep in LPM0 until the end of block interrupt; interrupts stay off
+	 * between the test and the sleep so that it cannot slip in between. */
+	oldSREG = READ_SR;
+	__dint();
+	while (block_running) {
+		__bis_SR_register(CPUOFF + GIE);
+		__dint();
+	}
+	WRITE_SR(oldSREG);
+	return true;
+}
+#else
+boolean analogReadBlockStart(const uint8_t *pins, uint8_t count, uint16_t *buffer, uint16_t samples, uint32_t rate)
+{
+	return false;
+}
+
+boolean analogReadBlockDone(void)
+{
+	return true;
+}
+
+void analogReadBlockStop(void)
+{
+}
+
+boolean analogReadBlock(const uint8_t *pins, uint8_t count, uint16_t *buffer, uint16_t samples, uint32_t rate)
+{
+	return false;
+}
+#endif
+
 #if defined(__MSP430_HAS_ADC10__)
 __attribute__((interrupt(ADC10_VECTOR)))
 void ADC10_ISR(void)
 {
+    if (block_running)                        // transfer controller filled the block
+        blockFinish();
     __bic_SR_register_on_exit(CPUOFF);        // return to active mode
 }
 #endif
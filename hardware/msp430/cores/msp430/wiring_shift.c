@@ -61,3 +61,59 @@ void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t val)
 		digitalWrite(clockPin, LOW);		
 	}
 }
+
+/*
+ * PxOUT bit sets and clears are single bis/bic instructions, so they need no
+ * interrupt masking, and cost a few cycles per edge instead of a
+ * digitalWrite() each. The USCI stays with the SPI library.
+ */
+void shiftOutBuffer(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, const uint8_t *buf, size_t len)
+{
+	volatile uint8_t *dataOut, *clockOut;
+	uint8_t dataBit, clockBit, val, mask;
+
+	if (digitalPinToPort(dataPin) == NOT_A_PORT || digitalPinToPort(clockPin) == NOT_A_PORT)
+		return;
+	dataOut = portOutputRegister(digitalPinToPort(dataPin));
+	dataBit = digitalPinToBitMask(dataPin);
+	clockOut = portOutputRegister(digitalPinToPort(clockPin));
+	clockBit = digitalPinToBitMask(clockPin);
+
+	while (len--) {
+		val = *buf++;
+		for (mask = bitOrder == LSBFIRST ? 0x01 : 0x80; mask;
+		     mask = bitOrder == LSBFIRST ? mask << 1 : mask >> 1) {
+			if (val & mask)
+				*dataOut |= dataBit;
+			else
+				*dataOut &= ~dataBit;
+			*clockOut |= clockBit;
+			*clockOut &= ~clockBit;
+		}
+	}
+}
+
+void shiftInBuffer(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t *buf, size_t len)
+{
+	volatile uint8_t *dataIn, *clockOut;
+	uint8_t dataBit, clockBit, val, mask;
+
+	if (digitalPinToPort(dataPin) == NOT_A_PORT || digitalPinToPort(clockPin) == NOT_A_PORT)
+		return;
+	dataIn = portInputRegister(digitalPinToPort(dataPin));
+	dataBit = digitalPinToBitMask(dataPin);
+	clockOut = portOutputRegister(digitalPinToPort(clockPin));
+	clockBit = digitalPinToBitMask(clockPin);
+
+	while (len--) {
+		val = 0;
+		for (mask = bitOrder == LSBFIRST ? 0x01 : 0x80; mask;
+		     mask = bitOrder == LSBFIRST ? mask << 1 : mask >> 1) {
+			*clockOut |= clockBit;
+			if (*dataIn & dataBit)
+				val |= mask;
+			*clockOut &= ~clockBit;
+		}
+		*buf++ = val;
+	}
+}
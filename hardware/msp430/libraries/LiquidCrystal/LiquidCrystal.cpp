@@ -78,6 +78,14 @@ void LiquidCrystal::init(uint8_t fourbitmode, uint8_t rs, uint8_t rw, uint8_t en
     _displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
   else 
     _displayfunction = LCD_8BITMODE | LCD_1LINE | LCD_5x8DOTS;
+
+  // Data pins on one port are set up once and written all at once
+  uint8_t count = fourbitmode ? 4 : 8;
+  if (pinGroupInit(&_data_group, _data_pins, count)) {
+    for (int i = 0; i < count; i++) {
+      pinMode(_data_pins[i], OUTPUT);
+    }
+  }
   
 }
 
@@ -291,18 +299,26 @@ void LiquidCrystal::pulseEnable(void) {
 }
 
 void LiquidCrystal::write4bits(uint8_t value) {
-  for (int i = 0; i < 4; i++) {
-    pinMode(_data_pins[i], OUTPUT);
-    digitalWrite(_data_pins[i], (value >> i) & 0x01);
+  if (_data_group.count) {
+    pinGroupWrite(&_data_group, value);
+  } else {
+    for (int i = 0; i < 4; i++) {
+      pinMode(_data_pins[i], OUTPUT);
+      digitalWrite(_data_pins[i], (value >> i) & 0x01);
+    }
   }
 
   pulseEnable();
 }
 
 void LiquidCrystal::write8bits(uint8_t value) {
-  for (int i = 0; i < 8; i++) {
-    pinMode(_data_pins[i], OUTPUT);
-    digitalWrite(_data_pins[i], (value >> i) & 0x01);
+  if (_data_group.count) {
+    pinGroupWrite(&_data_group, value);
+  } else {
+    for (int i = 0; i < 8; i++) {
+      pinMode(_data_pins[i], OUTPUT);
+      digitalWrite(_data_pins[i], (value >> i) & 0x01);
+    }
   }
   
   pulseEnable();
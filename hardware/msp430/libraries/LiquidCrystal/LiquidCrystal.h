@@ -3,6 +3,7 @@
 
 #include <inttypes.h>
 #include "Print.h"
+#include "pingroup.h"
 
 // commands
 #define LCD_CLEARDISPLAY 0x01
@@ -93,6 +94,7 @@ private:
   uint8_t _rw_pin; // LOW: write to LCD.  HIGH: read from LCD.
   uint8_t _enable_pin; // activated by a HIGH pulse.
   uint8_t _data_pins[8];
+  PinGroup _data_group; // the data pins, if all on one port
 
   uint8_t _displayfunction;
   uint8_t _displaycontrol;
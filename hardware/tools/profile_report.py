@@ -0,0 +1,87 @@
+#!/usr/bin/env python
+"""Turn the profileDump() output of the lm4f and cc3200 cores into a report.
+
+usage: profile_report.py [-s total|count|mean|max] [file ...]
+
+Reads serial logs from the files, or from standard input, picks out the
+blocks between "#profile <F_CPU>" and "#end" and prints one line per zone,
+sorted by the chosen column, largest first. When a log holds several
+dumps the last one of each zone counts, as the counts are cumulative.
+"""
+
+import argparse
+import sys
+
+
+def parse(lines):
+    """Return (cpu_hz, {name: (count, min, max, total)}) from a log."""
+    cpu_hz = None
+    zones = {}
+    block = None
+    for line in lines:
+        line = line.strip()
+        if line.startswith('#profile'):
+            block = {}
+            fields = line.split()
+            if len(fields) > 1:
+                cpu_hz = int(fields[1].rstrip('L'))
+        elif line == '#end':
+            if block is not None:
+                zones.update(block)
+            block = None
+        elif block is not None:
+            fields = line.split('\t')
+            if len(fields) != 5:
+                continue    # other output mixed in with the dump
+            try:
+                block[fields[0]] = tuple(int(f) for f in fields[1:])
+            except ValueError:
+                continue
+    return cpu_hz, zones
+
+
+def report(cpu_hz, zones, key, out):
+    rows = []
+    for name, (count, low, high, total) in zones.items():
+        rows.append({'name': name, 'count': count, 'min': low, 'max': high,
+                     'total': total, 'mean': total / float(count)})
+    rows.sort(key=lambda row: row[key], reverse=True)
+    grand = sum(row['total'] for row in rows) or 1
+
+    width = max([len(row['name']) for row in rows] + [4])
+    out.write('%-*s %10s %10s %12s %10s %14s %6s\n' % (
+        width, 'zone', 'count', 'min', 'mean', 'max', 'total', '%'))
+    for row in rows:
+        out.write('%-*s %10d %10d %12.1f %10d %14d %6.1f\n' % (
+            width, row['name'], row['count'], row['min'], row['mean'],
+            row['max'], row['total'], 100.0 * row['total'] / grand))
+    if cpu_hz:
+        out.write('\ncycles at %.1f MHz: 1 us = %d cycles, %.3f ms in all zones\n'
+                  % (cpu_hz / 1e6, cpu_hz // 1000000, grand * 1000.0 / cpu_hz))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('-s', '--sort', default='total',
+                        choices=['total', 'count', 'mean', 'max'])
+    parser.add_argument('files', nargs='*')
+    args = parser.parse_args()
+
+    lines = []
+    if args.files:
+        for name in args.files:
+            with open(name) as f:
+                lines.extend(f)
+    else:
+        lines = sys.stdin
+
+    cpu_hz, zones = parse(lines)
+    if not zones:
+        sys.stderr.write('no profileDump() output found\n')
+        return 1
+    report(cpu_hz, zones, args.sort, sys.stdout)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
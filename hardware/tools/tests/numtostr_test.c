@@ -0,0 +1,195 @@
+/*
+  numtostr_test.c - Host check and benchmark of the core numtostr.c against
+  the C library's printf
+
+  cc -O2 -Wall -Wextra -o numtostr_test numtostr_test.c -lm && ./numtostr_test
+
+  The source is shared by all cores. It is built twice, once with the
+  reciprocal division by 100 of the 32 bit cores and once with the plain
+  division the 16 bit cores use. Both builds are checked against
+  snprintf() and timed against it. The times are host times only; they
+  show the relative cost of the two base 10 loops, not msp430 or c2000
+  cycles.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#define NUMTOSTR_RECIPROCAL 1
+#define ultostr     recipUltostr
+#define ltostr      recipLtostr
+#define dtostr      recipDtostr
+#define ftostr      recipFtostr
+#include "../../lm4f/cores/lm4f/numtostr.c"
+#undef NUMTOSTR_RECIPROCAL
+#undef ultostr
+#undef ltostr
+#undef dtostr
+#undef ftostr
+#undef _NUMTOSTR_
+
+/* The file statics are defined again; rename them as well */
+#define digitPairs  divDigitPairs
+#define lowerDigits divLowerDigits
+#define upperDigits divUpperDigits
+#define finish      divFinish
+#define ultostr10   divUltostr10
+#define fixtostr    divFixtostr
+#define NUMTOSTR_RECIPROCAL 0
+#define ultostr     divUltostr
+#define ltostr      divLtostr
+#define dtostr      divDtostr
+#define ftostr      divFtostr
+#include "../../lm4f/cores/lm4f/numtostr.c"
+#undef ultostr
+#undef ltostr
+#undef dtostr
+#undef ftostr
+
+typedef size_t (*ULFunc)(unsigned long, char *, int, int);
+typedef size_t (*LFunc)(long, char *, int, int);
+typedef size_t (*DFunc)(double, char *, unsigned char);
+typedef size_t (*FFunc)(float, char *, unsigned char);
+
+static unsigned long failures;
+
+static void expect(const char *what, const char *got, const char *want)
+{
+    if (strcmp(got, want) && failures++ < 20)
+        printf("%s: got \"%s\", want \"%s\"\n", what, got, want);
+}
+
+static unsigned long random32(void)
+{
+    unsigned long v = ((unsigned long)rand() << 16) ^ (unsigned long)rand();
+
+    /* Spread over all magnitudes, not just the large ones */
+    return (v & 0xFFFFFFFFUL) >> (rand() % 32);
+}
+
+/* Reference for the bases printf lacks */
+static void reference(unsigned long v, char *buf, int base, int upper)
+{
+    const char *digits = upper ? "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                               : "0123456789abcdefghijklmnopqrstuvwxyz";
+    char tmp[72], *p = tmp + sizeof(tmp);
+
+    *--p = 0;
+    do {
+        *--p = digits[v % base];
+        v /= base;
+    } while (v);
+    strcpy(buf, p);
+}
+
+static void checkIntegers(const char *name, ULFunc ul, LFunc l)
+{
+    char got[72], want[72], what[64];
+    unsigned long v;
+    long i;
+    int base;
+
+    snprintf(what, sizeof(what), "%s integers", name);
+    for (i = 0; i < 1000000; i++) {
+        v = random32();
+        ul(v, got, 10, 0);
+        snprintf(want, sizeof(want), "%lu", v);
+        expect(what, got, want);
+
+        l((long)(int32_t)v, got, 10, 0);
+        snprintf(want, sizeof(want), "%ld", (long)(int32_t)v);
+        expect(what, got, want);
+
+        ul(v, got, 16, 1);
+        snprintf(want, sizeof(want), "%lX", v);
+        expect(what, got, want);
+
+        base = 2 + rand() % 35;
+        ul(v, got, base, 0);
+        reference(v, want, base, 0);
+        expect(what, got, want);
+    }
+}
+
+static void checkFloats(const char *name, DFunc d, FFunc f)
+{
+    char got[64], want[64], what[64];
+    double v;
+    float fv;
+    long i;
+    int digits;
+
+    snprintf(what, sizeof(what), "%s floats", name);
+    for (i = 0; i < 300000; i++) {
+        digits = rand() % 10;
+
+        /* Random magnitude below 2^32, and exact halves to test ties */
+        v = ldexp((double)random32() + rand() / (double)RAND_MAX, -(rand() % 100));
+        if (i % 4 == 0)
+            v = (rand() % 100000) / 2.0 / pow(10, digits);
+        if (i % 1000 == 0)
+            v = ldexp(rand(), -1000 - rand() % 100);    /* subnormal */
+        if (rand() & 1)
+            v = -v;
+
+        /* Negative zero prints without a sign, as Print always did */
+        d(v, got, digits);
+        snprintf(want, sizeof(want), "%.*f", digits, v == 0 ? 0.0 : v);
+        expect(what, got, want);
+
+        fv = (float)v;
+        f(fv, got, digits);
+        snprintf(want, sizeof(want), "%.*f", digits, fv == 0 ? 0.0 : (double)fv);
+        expect(what, got, want);
+    }
+}
+
+static double seconds(void)
+{
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+static void bench(void)
+{
+    static unsigned long values[4096];
+    volatile size_t sink = 0;
+    char buf[72];
+    double t;
+    long n;
+    int i;
+
+    for (i = 0; i < 4096; i++)
+        values[i] = random32();
+
+    t = seconds();
+    for (n = 0; n < 5000000; n++)
+        sink += recipUltostr(values[n & 4095], buf, 10, 0);
+    printf("ultostr base 10, reciprocal %6.1f ns\n", (seconds() - t) * 200);
+
+    t = seconds();
+    for (n = 0; n < 5000000; n++)
+        sink += divUltostr(values[n & 4095], buf, 10, 0);
+    printf("ultostr base 10, divide     %6.1f ns\n", (seconds() - t) * 200);
+
+    t = seconds();
+    for (n = 0; n < 5000000; n++)
+        sink += snprintf(buf, sizeof(buf), "%lu", values[n & 4095]);
+    printf("snprintf %%lu                %6.1f ns\n", (seconds() - t) * 200);
+    (void)sink;
+}
+
+int main(void)
+{
+    srand(1);
+    checkIntegers("reciprocal", recipUltostr, recipLtostr);
+    checkIntegers("divide", divUltostr, divLtostr);
+    checkFloats("reciprocal", recipDtostr, recipFtostr);
+    checkFloats("divide", divDtostr, divFtostr);
+    bench();
+
+    printf("Mismatches: %lu\n%s\n", failures, failures ? "FAIL" : "PASS");
+    return failures != 0;
+}
@@ -0,0 +1,110 @@
+/*
+  ringspan_test.c - Host check of the HardwareSerial ring spans behind
+  readRegion() and writeRegion() in the lm4f, cc3200 and msp430 cores
+
+  cc -O2 -Wall -Wextra -o ringspan_test ringspan_test.c && ./ringspan_test
+
+  Every read and write position of rings of several sizes is compared with
+  a byte by byte walk of the ring. The lm4f indices also run across the
+  wrap of unsigned long.
+*/
+
+#include <stdio.h>
+#include <limits.h>
+
+#define ringReadSpan    lm4fReadSpan
+#define ringWriteSpan   lm4fWriteSpan
+#include "../../lm4f/cores/lm4f/ringspan.h"
+#undef _RINGSPAN_
+#undef ringReadSpan
+#undef ringWriteSpan
+
+#define ringReadSpan    cc3200ReadSpan
+#define ringWriteSpan   cc3200WriteSpan
+#include "../../cc3200/cores/cc3200/ringspan.h"
+#undef _RINGSPAN_
+#undef ringReadSpan
+#undef ringWriteSpan
+
+#define ringReadSpan    msp430ReadSpan
+#define ringWriteSpan   msp430WriteSpan
+#include "../../msp430/cores/msp430/ringspan.h"
+
+static unsigned long failures;
+
+static void expect(const char *what, unsigned long size, unsigned long read,
+                   unsigned long write, unsigned long got, unsigned long want)
+{
+    if (got != want && failures++ < 20)
+        printf("%s size %lu read %lu write %lu: got %lu, want %lu\n",
+               what, size, read, write, got, want);
+}
+
+/* Bytes from position pos up to count of them, stopping at the end of the ring */
+static unsigned long walk(unsigned long pos, unsigned long count, unsigned long size)
+{
+    unsigned long n = 0;
+
+    while (n < count && pos + n < size)
+        n++;
+    return n;
+}
+
+/* Free running indices, power of two sizes, one slot is not reserved */
+static void checkFreeRunning(unsigned long size)
+{
+    static const unsigned long bases[] = { 0, 1, 1000, ULONG_MAX - 70 };
+    unsigned long b, read, used, write;
+
+    for (b = 0; b < sizeof(bases) / sizeof(bases[0]); b++) {
+        for (read = bases[b]; read != bases[b] + 2 * size + 3; read++) {
+            for (used = 0; used <= size; used++) {
+                write = read + used;
+                expect("lm4f read", size, read, write,
+                       lm4fReadSpan(read, write, size),
+                       walk(read & (size - 1), used, size));
+                expect("lm4f write", size, read, write,
+                       lm4fWriteSpan(read, write, size),
+                       walk(write & (size - 1), size - used, size));
+            }
+        }
+    }
+}
+
+/* Positions below size, any size, one slot stays empty */
+static void checkReserved(const char *core, unsigned long size,
+                          unsigned long (*readSpan)(unsigned long, unsigned long, unsigned long),
+                          unsigned long (*writeSpan)(unsigned long, unsigned long, unsigned long))
+{
+    unsigned long read, write, used;
+    char what[32];
+
+    for (read = 0; read < size; read++) {
+        for (write = 0; write < size; write++) {
+            used = (write + size - read) % size;
+            snprintf(what, sizeof(what), "%s read", core);
+            expect(what, size, read, write, readSpan(read, write, size),
+                   walk(read, used, size));
+            snprintf(what, sizeof(what), "%s write", core);
+            expect(what, size, read, write, writeSpan(read, write, size),
+                   walk(write, size - 1 - used, size));
+        }
+    }
+}
+
+int main(void)
+{
+    static const unsigned long sizes[] = { 1, 2, 4, 16, 64, 256 };
+    unsigned long i, size;
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+        checkFreeRunning(sizes[i]);
+
+    for (size = 2; size <= 130; size++) {
+        checkReserved("cc3200", size, cc3200ReadSpan, cc3200WriteSpan);
+        checkReserved("msp430", size, msp430ReadSpan, msp430WriteSpan);
+    }
+
+    printf("Mismatches: %lu\n%s\n", failures, failures ? "FAIL" : "PASS");
+    return failures != 0;
+}
@@ -0,0 +1,172 @@
+/*
+  timebase_test.c - Host check of the lm4f timebase arithmetic behind
+  millis(), micros(), micros64(), nanos() and delayMicroseconds()
+
+  cc -O2 -Wall -Wextra -o timebase_test timebase_test.c && ./timebase_test
+
+  The header is built for 80 MHz and 120 MHz. A 64 bit count of F_CPU
+  cycles since reset is split into the wrap count and the Timer5 value the
+  core would read. Every result is compared with the same time worked out
+  from the cycle count directly. The times are taken close to each Timer5
+  wrap, close to where millis() and micros() roll over, and at random
+  points up to the end of the 32 bit wrap count.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define F_CPU 80000000UL
+#define timebaseWraps       wraps80
+#define timebaseElapsed     elapsed80
+#define timebaseMillis      millis80
+#define timebaseMicros      micros80
+#define timebaseMicros64    micros64_80
+#define timebaseNanos       nanos80
+#include "../../lm4f/cores/lm4f/timebase.h"
+static const uint32_t wrapCycles80 = TIMEBASE_WRAP_CYCLES;
+#undef _TIMEBASE_
+#undef TIMEBASE_CYCLES_PER_US
+#undef TIMEBASE_CYCLES_PER_MS
+#undef TIMEBASE_WRAP_MS
+#undef TIMEBASE_WRAP_CYCLES
+#undef F_CPU
+#undef timebaseWraps
+#undef timebaseElapsed
+#undef timebaseMillis
+#undef timebaseMicros
+#undef timebaseMicros64
+#undef timebaseNanos
+
+#define F_CPU 120000000UL
+#define timebaseWraps       wraps120
+#define timebaseElapsed     elapsed120
+#define timebaseMillis      millis120
+#define timebaseMicros      micros120
+#define timebaseMicros64    micros64_120
+#define timebaseNanos       nanos120
+#include "../../lm4f/cores/lm4f/timebase.h"
+static const uint32_t wrapCycles120 = TIMEBASE_WRAP_CYCLES;
+
+struct timebase {
+    const char *name;
+    uint64_t cpu;
+    uint32_t wrapCycles;
+    uint32_t (*wraps)(uint32_t, uint32_t, int);
+    uint32_t (*elapsed)(uint32_t, uint32_t);
+    uint32_t (*millis)(uint32_t, uint32_t);
+    uint32_t (*micros)(uint32_t, uint32_t);
+    uint64_t (*micros64)(uint32_t, uint32_t);
+    uint64_t (*nanos)(uint32_t, uint32_t);
+};
+
+static const struct timebase timebases[] = {
+    { "80 MHz", 80000000, 0, wraps80, elapsed80, millis80, micros80,
+      micros64_80, nanos80 },
+    { "120 MHz", 120000000, 0, wraps120, elapsed120, millis120, micros120,
+      micros64_120, nanos120 },
+};
+
+static unsigned long failures;
+
+static void fail(const struct timebase *tb, const char *what, uint64_t cycles,
+                 uint64_t got, uint64_t expect)
+{
+    if (failures++ < 10)
+        printf("%s %s at cycle %llu: got %llu, expected %llu\n", tb->name,
+               what, (unsigned long long)cycles, (unsigned long long)got,
+               (unsigned long long)expect);
+}
+
+/* Every reading of the time at one cycle count */
+static void checkAt(const struct timebase *tb, uint64_t cycles)
+{
+    uint32_t wraps = cycles / tb->wrapCycles;
+    uint32_t count = cycles % tb->wrapCycles;
+    uint64_t us = cycles / (tb->cpu / 1000000);
+    uint64_t ns = (uint64_t)((unsigned __int128)cycles * 1000 / (tb->cpu / 1000000));
+
+    if (tb->millis(wraps, count) != (uint32_t)(cycles / (tb->cpu / 1000)))
+        fail(tb, "millis", cycles, tb->millis(wraps, count),
+             (uint32_t)(cycles / (tb->cpu / 1000)));
+    if (tb->micros(wraps, count) != (uint32_t)us)
+        fail(tb, "micros", cycles, tb->micros(wraps, count), (uint32_t)us);
+    if (tb->micros64(wraps, count) != us)
+        fail(tb, "micros64", cycles, tb->micros64(wraps, count), us);
+    if (tb->nanos(wraps, count) != ns)
+        fail(tb, "nanos", cycles, tb->nanos(wraps, count), ns);
+
+    /*
+     * The wrap interrupt is pending but has not run: the count was read
+     * after the wrap, or just before it when the counter is near the top.
+     */
+    if (wraps && count < tb->wrapCycles / 4 && tb->wraps(wraps - 1, count, 1) != wraps)
+        fail(tb, "pending wrap", cycles, tb->wraps(wraps - 1, count, 1), wraps);
+    if (count >= tb->wrapCycles / 2 && tb->wraps(wraps, count, 1) != wraps)
+        fail(tb, "wrap after read", cycles, tb->wraps(wraps, count, 1), wraps);
+    if (tb->wraps(wraps, count, 0) != wraps)
+        fail(tb, "no wrap", cycles, tb->wraps(wraps, count, 0), wraps);
+}
+
+/* A delayMicroseconds() step from one cycle count to a later one */
+static void checkElapsed(const struct timebase *tb, uint64_t from, uint32_t cycles)
+{
+    uint32_t start = from % tb->wrapCycles;
+    uint32_t now = (from + cycles) % tb->wrapCycles;
+
+    if (tb->elapsed(start, now) != cycles)
+        fail(tb, "elapsed", from, tb->elapsed(start, now), cycles);
+}
+
+static uint64_t random64(void)
+{
+    return ((uint64_t)rand() << 62) ^ ((uint64_t)rand() << 31) ^ rand();
+}
+
+static void checkNear(const struct timebase *tb, uint64_t cycles)
+{
+    int64_t d;
+
+    for (d = -2000; d <= 2000; d++) {
+        if ((int64_t)cycles + d < 0) continue;
+        checkAt(tb, cycles + d);
+        checkElapsed(tb, cycles + d, 3000 + d);
+    }
+}
+
+int main(void)
+{
+    struct timebase tbs[2];
+    uint64_t end, cycles;
+    unsigned i, t;
+
+    tbs[0] = timebases[0];
+    tbs[0].wrapCycles = wrapCycles80;
+    tbs[1] = timebases[1];
+    tbs[1].wrapCycles = wrapCycles120;
+
+    for (t = 0; t < 2; t++) {
+        const struct timebase *tb = &tbs[t];
+
+        /* The last cycle the 32 bit wrap count can reach */
+        end = (uint64_t)0xFFFFFFFF * tb->wrapCycles + tb->wrapCycles - 1;
+
+        for (i = 0; i < 100; i++)
+            checkNear(tb, (uint64_t)i * tb->wrapCycles);
+        for (i = 1; i < 4; i++) {
+            /* micros() and millis() rolling over */
+            checkNear(tb, ((uint64_t)i << 32) * (tb->cpu / 1000000));
+            checkNear(tb, ((uint64_t)i << 32) * (tb->cpu / 1000));
+        }
+        checkNear(tb, end - 2000);
+
+        for (i = 0; i < 2000000; i++) {
+            cycles = random64() % end;
+            checkAt(tb, cycles);
+            checkElapsed(tb, cycles, random64() % tb->wrapCycles);
+        }
+    }
+
+    printf("Mismatches: %lu\n%s\n", failures, failures ? "FAIL" : "PASS");
+    return failures != 0;
+}
@@ -0,0 +1,185 @@
+/*
+  wstring_test.cpp - Host check and benchmark of the core String class
+
+  c++ -O2 -Wall -Wextra -o wstring_test wstring_test.cpp && ./wstring_test
+
+  The lm4f WString.cpp is built on the host with malloc(), realloc() and
+  free() counted. Random sequences of assignments, +=, chains of + and
+  moves are checked against std::string. The patterns sketches use to
+  build text are then run and the heap calls and time each one takes are
+  printed. The heap call counts are the same on the target; the times are
+  host times only.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+
+static unsigned long heapCalls;
+
+static void *countMalloc(size_t n) { heapCalls++; return malloc(n); }
+static void *countRealloc(void *p, size_t n) { heapCalls++; return realloc(p, n); }
+static void countFree(void *p) { if (p) heapCalls++; free(p); }
+
+#include "../../lm4f/cores/lm4f/WString.h"
+#define malloc  countMalloc
+#define realloc countRealloc
+#define free    countFree
+#include "../../lm4f/cores/lm4f/WString.cpp"
+#undef malloc
+#undef realloc
+#undef free
+#include "../../lm4f/cores/lm4f/numtostr.c"
+
+static unsigned long failures;
+
+static void check(const char *what, const String &got, const std::string &expect)
+{
+    if (!got || expect != got.c_str() || got.length() != expect.size()) {
+        if (failures++ < 10)
+            printf("%s: got \"%s\", expected \"%s\"\n", what,
+                   got ? got.c_str() : "(invalid)", expect.c_str());
+    }
+}
+
+static std::string randomText(void)
+{
+    std::string s;
+    int n = rand() % 3 ? rand() % 12 : rand() % 200;
+
+    while (n--) s += (char)('a' + rand() % 26);
+    return s;
+}
+
+/* Random edits of a String and a std::string kept side by side */
+static void checkRandom(void)
+{
+    String s;
+    std::string ref;
+    int i;
+
+    for (i = 0; i < 200000; i++) {
+        std::string a = randomText(), b = randomText();
+        String sa(a.c_str()), sb(b.c_str());
+        long n = rand() - RAND_MAX / 2;
+        char c = 'A' + rand() % 26;
+
+        switch (rand() % 9) {
+        case 0: s = sa; ref = a; break;
+        case 1: s += sa; ref += a; break;
+        case 2: s += c; ref += c; break;
+        case 3: s += n; ref += std::to_string(n); break;
+        case 4: s = sa + sb; ref = a + b; break;
+        case 5: s = sa + c + n + b.c_str() + sb; ref = a + c + std::to_string(n) + b + b; break;
+        case 6: s = s + sa; ref = ref + a; break;
+        case 7: s = String(sa + "-" + sb); ref = a + "-" + b; break;
+        case 8: if (ref.size() > 2000) { s = ""; ref.clear(); } break;
+        }
+        check("random", s, ref);
+        String t(s);
+        check("copy", t, ref);
+        String u(std::move(t));
+        check("move", u, ref);
+    }
+}
+
+static void checkEdges(void)
+{
+    String s((const char *)NULL);
+
+    check("short chain", String("ab") + "c" + 'd' + 5, "abcd5");
+    check("null start", String("") + "", "");
+    if (s) failures++;
+    String t = String("x") + s;
+    if (t) failures++;
+    s = "0123456789012345678901234567890123456789012345678901234567890123456789";
+    check("long chain", s + s + 'x', std::string(s.c_str()) + s.c_str() + 'x');
+
+    /* A chain that fits the sum buffer allocates only the result */
+    heapCalls = 0;
+    {
+        String a = "0123456789", m = a + "abcdefghij" + a + 42 + 'z';
+        check("sized chain", m, "0123456789abcdefghij012345678942z");
+    }
+    if (heapCalls != 2) {
+        failures++;
+        printf("sized chain: %lu heap calls, expected 2\n", heapCalls);
+    }
+}
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+#define RUNS 20000
+
+static void report(const char *what, unsigned long calls, double start)
+{
+    printf("%-28s %6.1f heap calls %8.1f ns\n", what, (double)calls / RUNS,
+           (now() - start) * 1e9 / RUNS);
+}
+
+/* The same patterns as the TestStringBuild sketch */
+static void benchmark(void)
+{
+    String name = "sensor", unit = "mV", s;
+    double start;
+    int i, j;
+
+    heapCalls = 0;
+    start = now();
+    for (i = 0; i < RUNS; i++) {
+        String t = name;
+        t += ':';
+        s = t;
+    }
+    report("short temporaries", heapCalls, start);
+
+    heapCalls = 0;
+    start = now();
+    for (i = 0; i < RUNS; i++) {
+        String line;
+        for (j = 0; j < 80; j++) line += (char)('a' + j % 26);
+        s = line;
+    }
+    report("80 chars with +=", heapCalls, start);
+
+    heapCalls = 0;
+    start = now();
+    for (i = 0; i < RUNS; i++) {
+        String msg = "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\n"
+                     "Content-Length: " + String(i) + "\r\n\r\n" + name + "=" + i + unit;
+        s = msg;
+    }
+    check("chain", s, std::string("HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\n"
+          "Content-Length: ") + std::to_string(RUNS - 1) + "\r\n\r\nsensor=" +
+          std::to_string(RUNS - 1) + "mV");
+    report("response joined with +", heapCalls, start);
+
+    heapCalls = 0;
+    start = now();
+    for (i = 0; i < RUNS; i++) {
+        String csv;
+        for (j = 0; j < 16; j++) {
+            csv += i + j;
+            csv += ',';
+        }
+        s = csv;
+    }
+    report("16 numbers with +=", heapCalls, start);
+}
+
+int main(void)
+{
+    checkEdges();
+    checkRandom();
+    benchmark();
+
+    printf("Mismatches: %lu\n%s\n", failures, failures ? "FAIL" : "PASS");
+    return failures != 0;
+}